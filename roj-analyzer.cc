@@ -89,4 +89,41 @@ roj_real_matrix* roj_analyzer :: get_chirp_rate (int a_code){
   }
 }
 
+/* ************************************************************************************************************************* */
+/**
+ * @type: method
+ * @brief: This function returns many distributions at once. This generic version calls estimators one by one, analyzers override it with a fused pass.
+ *
+ * @param [in] a_mask: A bitwise or of DIST_* codes.
+ *
+ * @return: A structure with pointers to obtained distributions (NULL if not requested). They have to be released by the caller.
+ */
+roj_estimator_images roj_analyzer :: get_distributions (int a_mask){
 
+  if(a_mask & DIST_DOF){
+    call_warning("in roj_analyzer :: get_distributions");
+    call_error("dof density is not available");
+  }
+
+  roj_estimator_images images;
+  memset(&images, 0x0, sizeof(roj_estimator_images));
+
+  if(a_mask & DIST_ENERGY)
+    images.energy = get_spectral_energy();
+  if(a_mask & DIST_IFREQ_1)
+    images.ifreq_1 = get_instantaneous_frequency_by_1_estimator();
+  if(a_mask & DIST_IFREQ_2)
+    images.ifreq_2 = get_instantaneous_frequency_by_2_estimator();
+  if(a_mask & DIST_DELAY)
+    images.delay = get_spectral_delay();
+  if(a_mask & DIST_CR_K)
+    images.k_rate = get_chirp_rate_by_k_estimator();
+  if(a_mask & DIST_CR_D)
+    images.d_rate = get_chirp_rate_by_d_estimator();
+  if(a_mask & DIST_CR_F)
+    images.f_rate = get_chirp_rate_by_f_estimator();
+  if(a_mask & DIST_CR_M)
+    images.m_rate = get_chirp_rate_by_m_estimator();
+
+  return images;
+}
@@ -36,6 +36,9 @@ class roj_real_matrix;
 #include "roj-stft-transform.hh"
 struct roj_stft_transform;
 
+#include "roj-estim-kernel.hh"
+struct roj_estimator_images;
+
 /* ************************************************************************************************************************* */
 /* macros */
 
@@ -75,6 +78,60 @@ struct roj_stft_transform;
 */
 #define IF_2_ESTIMATOR 1
 
+/**
+* @type: define
+* @brief: This is a bit of spectral energy in masks of get_distributions.
+*/
+#define DIST_ENERGY 0x001
+
+/**
+* @type: define
+* @brief: This is a bit of instantaneous frequency (first estimator) in masks of get_distributions.
+*/
+#define DIST_IFREQ_1 0x002
+
+/**
+* @type: define
+* @brief: This is a bit of instantaneous frequency (second estimator) in masks of get_distributions.
+*/
+#define DIST_IFREQ_2 0x004
+
+/**
+* @type: define
+* @brief: This is a bit of spectral delay in masks of get_distributions.
+*/
+#define DIST_DELAY 0x008
+
+/**
+* @type: define
+* @brief: This is a bit of chirp-rate (K estimator) in masks of get_distributions.
+*/
+#define DIST_CR_K 0x010
+
+/**
+* @type: define
+* @brief: This is a bit of chirp-rate (D estimator) in masks of get_distributions.
+*/
+#define DIST_CR_D 0x020
+
+/**
+* @type: define
+* @brief: This is a bit of chirp-rate (F estimator) in masks of get_distributions.
+*/
+#define DIST_CR_F 0x040
+
+/**
+* @type: define
+* @brief: This is a bit of chirp-rate (M estimator) in masks of get_distributions.
+*/
+#define DIST_CR_M 0x080
+
+/**
+* @type: define
+* @brief: This is a bit of degree of freedom density in masks of get_distributions.
+*/
+#define DIST_DOF 0x100
+
 /* ************************************************************************************************************************* */
 /* analyzer class definition */
 
@@ -93,7 +150,7 @@ protected:
   
 public:
  
-  ~roj_analyzer();
+  virtual ~roj_analyzer();
 
   void set_signal(roj_complex_signal*, int =1);
 
@@ -114,6 +171,9 @@ public:
   virtual roj_real_matrix* get_chirp_rate_by_m_estimator() = 0;
   virtual roj_real_matrix* get_chirp_rate_by_d_estimator() = 0;
   virtual roj_real_matrix* get_chirp_rate_by_f_estimator() = 0;
+
+  /* many distributions at once */
+  virtual roj_estimator_images get_distributions(int);
 };
 
 #endif
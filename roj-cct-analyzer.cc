@@ -24,6 +24,11 @@ roj_cct_analyzer :: roj_cct_analyzer (roj_array_config a_bank_conf, roj_window_g
   
   /* set null */
   m_chirprate = NULL;
+  m_extrapolation = false;
+  m_resolution = 0.0;
+  m_interpolation = false;
+  m_chirp_map = NULL;
+  m_chirp_bins = NULL;
 }
 
 /**
@@ -34,12 +39,16 @@ roj_cct_analyzer :: ~roj_cct_analyzer (){
 
   if(m_chirprate != NULL)
     delete m_chirprate;
+
+  if(m_chirp_map != NULL)
+    delete m_chirp_map;
+  clear_chirp_bins();
 }
 
 /* ************************************************************************************************************************* */
 /**
  * @type: method
- * @brief: This routine allows to set an instantaneous chirp-rate.
+ * @brief: This routine allows to set an instantaneous chirp-rate. A previous chirp-rate is replaced, then only columns of calculated STFT slots whose chirp-rate is changed are calculated again, so the analyzer can be used for iterative refinement of the chirp-rate.
  *
  * @param [in] a_crate: A pointer a distribution which stored the instantaneous chirp-rate.
  */
@@ -50,96 +59,363 @@ void roj_cct_analyzer :: set_chirp_rate (roj_real_array* a_crate){
     call_error("arg is null");
   }
 
-  if(m_chirprate != NULL){
-    call_warning("in roj_cct_analyzer :: set_chirp_rate");
-    call_error("only one chirprate can be set");
-  }
+  std::vector<double> rates = calc_rates();
+  delete m_chirprate;
+  delete m_chirp_map;
+  m_chirp_map = NULL;
 
   roj_array_config conf = a_crate->get_config();
   m_chirprate = new roj_real_array(conf);
-  int byte_size = conf.length * sizeof(double);
+  int byte_size = conf.length * sizeof(roj_real);
   memcpy(m_chirprate->m_data, a_crate->m_data, byte_size);
+
+  invalidate_rates(rates);
+}
+
+/**
+ * @type: method
+ * @brief: This routine allows to set a time-frequency chirp-rate, so each pixel can have its own chirp-rate. Chirp-rates are quantized to bins of a given resolution and one chirplet transform is calculated for each bin present in a column. Each pixel is taken from the transform of its bin. A previous chirp-rate is replaced as for a chirp-rate array.
+ *
+ * @param [in] a_crate: A pointer a distribution which stored the chirp-rate of pixels (e.g. an estimate of k_rate).
+ * @param [in] a_resolution: A resolution of bins in Hz/s.
+ */
+void roj_cct_analyzer :: set_chirp_rate (roj_real_matrix* a_crate, double a_resolution){
+
+  if(a_crate == NULL){
+    call_warning("in roj_cct_analyzer :: set_chirp_rate");
+    call_error("arg is null");
+  }
+
+  if(a_resolution <= 0.0){
+    call_warning("in roj_cct_analyzer :: set_chirp_rate");
+    call_error("resolution is not positive");
+  }
+
+  std::vector<double> rates = calc_rates();
+  delete m_chirprate;
+  delete m_chirp_map;
+  m_chirprate = NULL;
+
+  m_chirp_map = new roj_real_matrix(a_crate);
+  m_resolution = a_resolution;
+
+  invalidate_rates(rates);
+}
+
+/**
+ * @type: method
+ * @brief: This routine sets a resolution of chirp-rates of windows. Each chirp-rate is rounded to the nearest multiple of the resolution, so columns of close chirp-rates use the same cached windows. It trades accuracy of the chirp-rate for speed if the instantaneous chirp-rate changes smoothly.
+ *
+ * @param [in] a_resolution (default 0.0): A resolution in Hz/s (zero means that chirp-rates are not rounded).
+ */
+void roj_cct_analyzer :: set_rate_resolution (double a_resolution){
+
+  if(a_resolution < 0.0){
+    call_warning("in roj_cct_analyzer :: set_rate_resolution");
+    call_error("resolution is negative");
+  }
+
+  if(a_resolution == 0.0 and m_chirp_map != NULL){
+    call_warning("in roj_cct_analyzer :: set_rate_resolution");
+    call_error("resolution of bins has to be positive");
+  }
+
+  std::vector<double> rates = calc_rates();
+  m_resolution = a_resolution;
+  invalidate_rates(rates);
+}
+
+/**
+ * @type: method
+ * @brief: This routine sets a lookup of the chirp-rate. The nearest point of the chirp-rate is used by default, otherwise the chirp-rate is interpolated linearly between points (bilinearly for a time-frequency chirp-rate).
+ *
+ * @param [in] a_interpolation (default false): If true, chirp-rate is interpolated.
+ */
+void roj_cct_analyzer :: set_rate_interpolation (bool a_interpolation){
+
+  std::vector<double> rates = calc_rates();
+  m_interpolation = a_interpolation;
+  invalidate_rates(rates);
 }
 
 /* ************************************************************************************************************************* */
 /**
  * @type: private
- * @brief: This routine roj_calculate short-time Fourier transform (STFT).
+ * @brief: This routine sets the chirp-rate of the window generator for a given STFT column. The nearest value of the instantaneous chirp-rate is used.
  *
- * @param [in] a_d_order: An order of of window derivative with respect to time.
- * @param [in] a_t_order: An order of power of timeramp which is multiplied by the window waveform.
+ * @param [in] a_column: An index of STFT column.
+ * @param [in] a_window_gen: A pointer to the used window generator.
  *
- * @return: A pointer to the resultant STFT.
+ * @return: True if the chirp-rate is changed, so the window has to be generated again.
  */
-complex double ** roj_cct_analyzer :: transforming (int a_d_order, int a_t_order){
+bool roj_cct_analyzer :: update_window (int a_column, roj_window_generator* a_window_gen){
 
   /* check to chirprate is set */
   if(m_chirprate==NULL){
-    call_warning("in roj_cct_analyzer :: transforming");
+    call_warning("in roj_cct_analyzer :: update_window");
     call_error("chirp-rate is not set");
   }
 
-  /* allocate memory for stft */
-  complex double** stft = allocate_stft();
+  double c_rate = get_column_rate(a_column);
+  if(c_rate == a_window_gen->get_chirp_rate())
+    return false;
+  
+  a_window_gen->set_chirp_rate(c_rate);
+  return true;
+}
+
+/**
+ * @type: private
+ * @brief: This routine finds points of the chirp-rate used for a given position. The nearest point is used, or two neighbouring points if the chirp-rate is interpolated. Positions outside the chirp-rate use its border point.
+ *
+ * @param [in] a_position: A position in units of points (it can be fractional).
+ * @param [in] a_length: A number of points.
+ * @param [out] a_index: An index of the first point.
+ * @param [out] a_weight: A weight of the next point (zero if it is not used).
+ */
+void roj_cct_analyzer :: locate_point (double a_position, int a_length, int* a_index, double* a_weight){
+
+  int index = round(a_position);
+  if(index>=a_length+1 or index<-1)
+    if(!m_extrapolation){
+      m_extrapolation = true;
+      call_warning("extrapolation in chirprate");
+    }
 
-  /* tmp signal for fft - only length is used */
-  roj_signal_config tmp_conf;
-  tmp_conf.length = m_bank_config.length;    
-  roj_complex_signal* in_tmp = new roj_complex_signal(tmp_conf);
-  int start_index = (m_bank_config.length-m_window_gen->get_length()) / 2;
+  *a_weight = 0.0;
+  if(m_interpolation and a_position>0 and a_position<a_length-1){
+    index = floor(a_position);
+    *a_weight = a_position - index;
+  }
 
-  int byte_size_win = m_window_gen->get_length() * sizeof(complex double);
-  int byte_size_out = get_height() * sizeof(complex double);
+  if (index>=a_length)
+    index = a_length-1;
+  if (index<0)
+    index = 0;
+  *a_index = index;
+}
 
-  double delta = m_window_gen->get_rate() / m_bank_config.length;
-  int initial = (m_bank_config.min + m_window_gen->get_rate()/2) / delta;
+/**
+ * @type: private
+ * @brief: This routine returns the chirp-rate of a given STFT column (for the middle of its window).
+ *
+ * @param [in] a_column: An index of STFT column.
+ *
+ * @return: The chirp-rate (rounded to the resolution if it is set).
+ */
+double roj_cct_analyzer :: get_column_rate (int a_column){
 
   roj_array_config arr_conf = m_chirprate->get_config();
   roj_signal_config sig_conf = m_input_signal->get_config();
+  int curr_index = a_column*m_hop;
+
+  double time = sig_conf.start + ((double)curr_index + (double)m_window_gen->get_length()/2) / m_window_gen->get_rate();
+  double position = 0.0;
+  if(arr_conf.length>1)
+    position = (time - arr_conf.min) / m_chirprate->get_delta();
+
+  int index;
+  double weight;
+  locate_point(position, arr_conf.length, &index, &weight);
+        
+  double c_rate = m_chirprate->m_data[index];
+  if(weight > 0.0)
+    c_rate = (1.0-weight) * c_rate + weight * m_chirprate->m_data[index+1];
+
+  if(m_resolution > 0.0)
+    c_rate = m_resolution * floor(c_rate / m_resolution + 0.5);
+  return c_rate;
+}
+
+/**
+ * @type: private
+ * @brief: This routine returns the chirp-rate of a given pixel from the time-frequency chirp-rate.
+ *
+ * @param [in] a_column: An index of STFT column.
+ * @param [in] a_line: An index of STFT line.
+ *
+ * @return: The chirp-rate rounded to the resolution.
+ */
+double roj_cct_analyzer :: get_pixel_rate (int a_column, int a_line){
+
+  roj_image_config map_conf = m_chirp_map->get_config();
+  roj_signal_config sig_conf = m_input_signal->get_config();
+
+  /* time as for a chirp-rate array */
+  double x_position = 0.0;
+  if(map_conf.x.length>1){
+    double time = sig_conf.start + ((double)(a_column*m_hop) + (double)m_window_gen->get_length()/2) / m_window_gen->get_rate();
+    x_position = (time - map_conf.x.min) * (map_conf.x.length - 1) / (map_conf.x.max - map_conf.x.min);
+  }
+
+  /* frequency as for image lines */
+  double y_position = 0.0;
+  if(map_conf.y.length>1){
+    double freq = m_bank_config.min;
+    if(get_height()>1)
+      freq += a_line * (m_bank_config.max - m_bank_config.min) / (get_height() - 1);
+    y_position = (freq - map_conf.y.min) * (map_conf.y.length - 1) / (map_conf.y.max - map_conf.y.min);
+  }
+
+  int x_index, y_index;
+  double x_weight, y_weight;
+  locate_point(x_position, map_conf.x.length, &x_index, &x_weight);
+  locate_point(y_position, map_conf.y.length, &y_index, &y_weight);
+
+  double c_rate = get_map_value(x_index, y_index);
+  if(x_weight > 0.0 or y_weight > 0.0){
+    c_rate *= (1.0-x_weight) * (1.0-y_weight);
+    if(x_weight > 0.0)
+      c_rate += x_weight * (1.0-y_weight) * get_map_value(x_index+1, y_index);
+    if(y_weight > 0.0)
+      c_rate += (1.0-x_weight) * y_weight * get_map_value(x_index, y_index+1);
+    if(x_weight > 0.0 and y_weight > 0.0)
+      c_rate += x_weight * y_weight * get_map_value(x_index+1, y_index+1);
+  }
+
+  return m_resolution * floor(c_rate / m_resolution + 0.5);
+}
+
+/**
+ * @type: private
+ * @brief: This routine returns a point of the time-frequency chirp-rate. Points without an estimate use a plain window.
+ *
+ * @param [in] a_x: A time index.
+ * @param [in] a_y: A frequency index.
+ *
+ * @return: The chirp-rate or zero.
+ */
+double roj_cct_analyzer :: get_map_value (int a_x, int a_y){
+
+  double c_rate = m_chirp_map->m_data[a_x][a_y];
+  if(c_rate != c_rate or fabs(c_rate) >= ROJ_NO_ESTIMATE)
+    return 0.0;
+  return c_rate;
+}
+
+/**
+ * @type: private
+ * @brief: This routine returns the current chirp-rate of all columns (for a chirp-rate array) or of all pixels (for a time-frequency chirp-rate).
+ *
+ * @return: Chirp-rates, empty if the signal or the chirp-rate is not set.
+ */
+std::vector<double> roj_cct_analyzer :: calc_rates (){
+
+  std::vector<double> rates;
+  if(m_input_signal==NULL)
+    return rates;
+
+  int width = get_width();
+  int height = get_height();
+
+  if(m_chirprate!=NULL)
+    for(int n=0; n<width; n++)
+      rates.push_back(get_column_rate(n));
+
+  if(m_chirp_map!=NULL)
+    for(int n=0; n<width; n++)
+      for(int k=0; k<height; k++)
+	rates.push_back(get_pixel_rate(n, k));
+
+  return rates;
+}
+
+/**
+ * @type: private
+ * @brief: This routine invalidates columns of calculated slots whose chirp-rate is changed. All columns are invalidated if the kind of chirp-rate is changed.
+ *
+ * @param [in] a_rates: Chirp-rates which were used before the change (see calc_rates).
+ */
+void roj_cct_analyzer :: invalidate_rates (std::vector<double> a_rates){
+
+  std::vector<double> rates = calc_rates();
+  if(rates.empty())
+    return;
+
+  int width = get_width();
+  int step = rates.size() / width;
+  bool all = a_rates.size() != rates.size();
   
-  /* calculating spectrua by fft */
-  bool nline_flag1 = true;
-  bool nline_flag2 = true; 
-  for(int n=0; n<get_width();n++){
-    int curr_index = n*m_hop;
-    in_tmp->clear();
-
-    /* get nearest index */    
-    double time = sig_conf.start + ((double)curr_index + (double)m_window_gen->get_length()/2) / m_window_gen->get_rate();
-    int cr_index = m_chirprate->get_index_by_arg(time);
-    if (cr_index>=arr_conf.length){
-      cr_index = arr_conf.length-1;
-      if (nline_flag2 and cr_index>=arr_conf.length+1){
-	nline_flag2 = false;
-	call_warning("extrapolation in chirprate");
-      }
-    }
-    if (cr_index<0){
-      cr_index =0;
-      if(nline_flag1 and cr_index<-1){
-	nline_flag1 = false;
-	call_warning("extrapolation in chirprate");
+  std::vector<int> columns;
+  for(int n=0; n<width; n++){
+    bool changed = all;
+    for(int i=n*step; i<(n+1)*step and !changed; i++)
+      changed = rates[i] != a_rates[i];
+    if(changed)
+      columns.push_back(n);
+  }
+
+#ifdef ROJ_DEBUG_ON
+  call_info("changed chirp-rate columns: ", columns.size());
+#endif
+  invalidate_columns(columns);
+}
+
+/* ************************************************************************************************************************* */
+/**
+ * @type: private
+ * @brief: This routine returns chirp-rate bins of pixels if a time-frequency chirp-rate is set. Bins are created for the loaded signal, each pixel uses the chirp-rate rounded to a multiple of the resolution (see get_pixel_rate).
+ *
+ * @return: A pointer to bins (owned by the analyzer) or NULL.
+ */
+roj_chirp_bins* roj_cct_analyzer :: get_chirp_bins (){
+
+  if(m_chirp_map==NULL)
+    return NULL;
+
+  /* bins are valid for one signal */
+  clear_chirp_bins();
+
+  int width = get_width();
+  int height = get_height();
+
+  std::map<long, int> indexes;
+  std::vector<double> rates;
+
+  m_chirp_bins = new roj_chirp_bins;
+  m_chirp_bins->width = width;
+  m_chirp_bins->pixels = new int*[width];
+  
+  for(int n=0; n<width; n++){
+    m_chirp_bins->pixels[n] = new int[height];
+
+    for(int k=0; k<height; k++){
+      double c_rate = get_pixel_rate(n, k);
+
+      long q = (long)floor(c_rate / m_resolution + 0.5);
+      std::map<long, int>::iterator i = indexes.find(q);
+      if(i == indexes.end()){
+	i = indexes.insert(std::make_pair(q, (int)rates.size())).first;
+	rates.push_back(c_rate);
       }
+      m_chirp_bins->pixels[n][k] = i->second;
     }
-        
-    double c_rate = m_chirprate->m_data[cr_index];
-    m_window_gen->set_chirp_rate(c_rate);
+  }
 
-    roj_complex_signal* window_waveform = m_window_gen->get_window(a_d_order, a_t_order); 
-    memcpy(&in_tmp->m_waveform[start_index], &m_input_signal->m_waveform[curr_index], byte_size_win);
+  m_chirp_bins->count = rates.size();
+  m_chirp_bins->rates = new double[rates.size()];
+  for(int b=0; b<rates.size(); b++)
+    m_chirp_bins->rates[b] = rates[b];
 
-    for(int m=0; m<m_window_gen->get_length(); m++)
-      in_tmp->m_waveform[start_index+m] *= window_waveform->m_waveform[m];
+#ifdef ROJ_DEBUG_ON
+  call_info("chirp-rate bins: ", m_chirp_bins->count);
+#endif
+  return m_chirp_bins;
+}
 
-    roj_fourier_spectrum* out_tmp = in_tmp->get_spectrum();
-    memcpy(stft[n], &out_tmp->m_spectrum[initial], byte_size_out);
-    delete out_tmp;
+/**
+ * @type: private
+ * @brief: This routine releases chirp-rate bins.
+ */
+void roj_cct_analyzer :: clear_chirp_bins (){
 
-    print_progress(n+1, get_width(), "stft");
-    delete window_waveform;
-  }
+  if(m_chirp_bins == NULL)
+    return;
 
-  print_progress(0, 0, "stft");  
-  delete in_tmp;
-  return stft;
+  for(int n=0; n<m_chirp_bins->width; n++)
+    delete [] m_chirp_bins->pixels[n];
+  delete [] m_chirp_bins->pixels;
+  delete [] m_chirp_bins->rates;
+  delete m_chirp_bins;
+  m_chirp_bins = NULL;
 }
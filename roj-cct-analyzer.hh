@@ -25,6 +25,9 @@ class roj_xxt_analyzer;
 #include "roj-window-gener.hh"
 class roj_window_generator;
 
+#include "roj-real-matrix.hh"
+class roj_real_matrix;
+
 /* ************************************************************************************************************************* */
 /* changeable chirplet analyzer class definition */
 
@@ -34,10 +37,33 @@ class roj_cct_analyzer
 private:
   
   /* chirprate can be changed for each instant */
-  complex double ** transforming(int, int);
+  bool update_window(int, roj_window_generator*);
 
   /* external information about chirprate */
   roj_real_array *m_chirprate;
+  bool m_extrapolation;
+
+  /* chirp-rates are rounded to multiples of resolution (if positive) */
+  double m_resolution;
+
+  /* chirp-rates are interpolated linearly between points */
+  bool m_interpolation;
+
+  /* external time-frequency chirprate and its bins */
+  roj_real_matrix *m_chirp_map;
+  roj_chirp_bins *m_chirp_bins;
+  roj_chirp_bins* get_chirp_bins();
+  void clear_chirp_bins();
+
+  /* chirp-rates of columns and pixels */
+  void locate_point(double, int, int*, double*);
+  double get_column_rate(int);
+  double get_pixel_rate(int, int);
+  double get_map_value(int, int);
+
+  /* slots are invalidated only where chirp-rate is changed */
+  std::vector<double> calc_rates();
+  void invalidate_rates(std::vector<double>);
   
 public:
 
@@ -47,6 +73,9 @@ public:
 
   /* instantaneous chirp-rate setter */
   void set_chirp_rate(roj_real_array*);
+  void set_chirp_rate(roj_real_matrix*, double);
+  void set_rate_resolution(double =0.0);
+  void set_rate_interpolation(bool =false);
 };
 
 #endif
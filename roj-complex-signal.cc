@@ -47,7 +47,7 @@ roj_complex_signal :: roj_complex_signal (roj_real_array* a_real, roj_real_array
   m_config.start = conf.min;
   
   /* allocate memory for samples */
-  m_waveform = new complex double [m_config.length];
+  m_waveform = new roj_complex [m_config.length];
   if(a_imag==NULL)
     for(int n=0; n<m_config.length; n++)
       m_waveform[n] = a_real->m_data[n] + 0J;
@@ -83,8 +83,8 @@ roj_complex_signal :: roj_complex_signal (roj_signal_config a_conf){
   m_config = a_conf;
   
   /* allocate memory for samples */
-  m_waveform = new complex double [m_config.length];
-  int byte_size = m_config.length * sizeof(complex double);
+  m_waveform = new roj_complex [m_config.length];
+  int byte_size = m_config.length * sizeof(roj_complex);
   memset(m_waveform, 0x0, byte_size);
 }
 
@@ -117,8 +117,8 @@ roj_complex_signal :: roj_complex_signal (roj_complex_signal* a_sig){
   }
 
   /* allocate memory and copy samples */
-  m_waveform = new complex double [m_config.length];
-  int byte_size = m_config.length * sizeof(complex double);
+  m_waveform = new roj_complex [m_config.length];
+  int byte_size = m_config.length * sizeof(roj_complex);
   memcpy(m_waveform, a_sig->m_waveform, byte_size);
 
   call_info("copied samples: ", m_config.length);
@@ -173,8 +173,8 @@ roj_complex_signal :: roj_complex_signal (char* a_wav_filename, int a_channel_nu
   m_config.start = 0.0;
   m_config.length = info.frames;
   m_config.rate = (double)info.samplerate;
-  m_waveform = new complex double [m_config.length];
-  int byte_size = m_config.length * sizeof(complex double);
+  m_waveform = new roj_complex [m_config.length];
+  int byte_size = m_config.length * sizeof(roj_complex);
   memset(m_waveform, 0x0, byte_size);
   for (int n=0; n<loaded; n++)
     m_waveform[n] = buffer[n*info.channels+a_channel_number];
@@ -309,7 +309,7 @@ roj_real_array* roj_complex_signal :: get_imag (){
  */
 void roj_complex_signal :: clear (){
   
-  int byte_size = m_config.length * sizeof(complex double);
+  int byte_size = m_config.length * sizeof(roj_complex);
   memset(m_waveform, 0x0, byte_size);
 }
 
@@ -370,7 +370,7 @@ int roj_complex_signal :: copy (roj_complex_signal* a_sig, int a_index){
   if (m_config.length>conf.length-a_index)
     min_length = conf.length-a_index;
   
-  int byte_size = min_length * sizeof(complex double);
+  int byte_size = min_length * sizeof(roj_complex);
   memcpy(m_waveform, &a_sig->m_waveform[a_index], byte_size);
 
   return min_length;
@@ -441,8 +441,8 @@ void roj_complex_signal :: decimate (int a_hop){
 
   /* allocate memory for samples */
   int new_length = 1 + m_config.length / a_hop;
-  complex double *waveform = new complex double [new_length];
-  int byte_size = new_length * sizeof(complex double);
+  roj_complex *waveform = new roj_complex [new_length];
+  int byte_size = new_length * sizeof(roj_complex);
   memset(waveform, 0x0, byte_size);
 
   /* assign samples */
@@ -478,8 +478,8 @@ void roj_complex_signal :: insert (int a_number, complex double a_value){
 
   /* allocate memory for samples */
   int new_length = m_config.length * (a_number+1);
-  complex double *waveform = new complex double [new_length];
-  int byte_size = new_length * sizeof(complex double);
+  roj_complex *waveform = new roj_complex [new_length];
+  int byte_size = new_length * sizeof(roj_complex);
   memset(waveform, 0x0, byte_size);
 
   /* insert samples */
@@ -541,10 +541,10 @@ unsigned int roj_complex_signal :: cut (double a_new_start, double a_new_stop){
     call_warning("in roj_complex_signal :: cut");
     call_error("new length is too short ");
   }
-  complex double* new_waveform = new complex double [new_length];
+  roj_complex* new_waveform = new roj_complex [new_length];
  
   /* copying of samples */
-  memcpy(new_waveform, &m_waveform[new_initial], sizeof(complex double) * new_length);
+  memcpy(new_waveform, &m_waveform[new_initial], sizeof(roj_complex) * new_length);
   delete m_waveform;
 
   /* actualization of configuration */
@@ -597,9 +597,9 @@ unsigned int roj_complex_signal :: append_head (double a_duration){
   if(number*m_config.rate != a_duration)
     call_warning("duration rate product is not integer");
 
-  complex double *waveform = new complex double [m_config.length + number];
-  memcpy(&waveform[number], m_waveform, m_config.length * sizeof(complex double));
-  memset(waveform, 0x0, number * sizeof(complex double));
+  roj_complex *waveform = new roj_complex [m_config.length + number];
+  memcpy(&waveform[number], m_waveform, m_config.length * sizeof(roj_complex));
+  memset(waveform, 0x0, number * sizeof(roj_complex));
 
   delete [] m_waveform;
 
@@ -629,9 +629,9 @@ unsigned int roj_complex_signal :: append_tail (double a_duration){
   if(number*m_config.rate != a_duration)
     call_warning("duration rate product is not integer");
   
-  complex double *waveform = new complex double [m_config.length + number];
-  memcpy(waveform, m_waveform, m_config.length * sizeof(complex double));
-  memset(&waveform[m_config.length], 0x0, number * sizeof(complex double));
+  roj_complex *waveform = new roj_complex [m_config.length + number];
+  memcpy(waveform, m_waveform, m_config.length * sizeof(roj_complex));
+  memset(&waveform[m_config.length], 0x0, number * sizeof(roj_complex));
 
   delete [] m_waveform;
 
@@ -749,7 +749,7 @@ roj_complex_signal* roj_complex_signal :: get_instantaneous_frequency (){
 
   roj_complex_signal* out = new roj_complex_signal(m_config);
   roj_complex_signal* equiv = NULL;
-  complex double* waveform;
+  roj_complex* waveform;
 
   if(!check_imag()){
     roj_hilbert_equiv *hilbert = new roj_hilbert_equiv(this);
@@ -785,7 +785,7 @@ roj_complex_signal* roj_complex_signal :: get_instantaneous_bandwidth (){
   
   roj_complex_signal* out = new roj_complex_signal(m_config);
   roj_complex_signal* equiv = NULL;
-  complex double* waveform;
+  roj_complex* waveform;
 
   if(!check_imag()){
     roj_hilbert_equiv *hilbert = new roj_hilbert_equiv(this);
@@ -821,7 +821,7 @@ roj_complex_signal* roj_complex_signal :: get_instantaneous_chirp_rate (){
 
   roj_complex_signal* out = new roj_complex_signal(m_config);
   roj_complex_signal* equiv = NULL;
-  complex double* waveform;
+  roj_complex* waveform;
 
   if(!check_imag()){
     roj_hilbert_equiv *hilbert = new roj_hilbert_equiv(this);
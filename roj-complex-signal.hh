@@ -99,7 +99,7 @@ private:
    * @type: field
    * @brief: This public field gives access to signal samples.
    */
-  complex double* m_waveform; 
+  roj_complex* m_waveform; 
 
   /* operators */
   void operator += (roj_complex_signal*);
@@ -0,0 +1,294 @@
+/* *************************************************** *
+ * This file is a part of ccROJ project (version 0-49) *
+ * distributed under GNU General Public License v3.0.  *
+ * Please visit the webpage: github.com/dsp-box/ccROJ  *
+ * for more information.                               *
+ *                       contact: Krzysztof Czarnecki  *
+ *                email: czarnecki.krzysiek@gmail.com  *
+ * *************************************************** */
+
+#include "roj-estim-kernel.hh"
+
+/* ************************************************************************************************************************* */
+/* rows of kernel buffers */
+#define ROJ_ROW_INV 0
+#define ROJ_ROW_D 1
+#define ROJ_ROW_D2 3
+#define ROJ_ROW_T 5
+#define ROJ_ROW_T2 7
+#define ROJ_ROW_DT 9
+#define ROJ_ROWS 11
+
+/* ************************************************************************************************************************* */
+/**
+* @type: function
+* @brief: This routine calculates a ratio of a slot to y. The result is stored in split real and imaginary arrays.
+*
+* @param [in] a_length: A line length.
+* @param [in] a_slot: A pointer to slot samples (interleaved real and imaginary parts).
+* @param [in] a_y: A pointer to y samples (interleaved real and imaginary parts).
+* @param [in] a_inv: A pointer to inverses of squared magnitudes of y (0 if y is 0).
+* @param [out] a_re: A pointer to real parts of the ratio.
+* @param [out] a_im: A pointer to imaginary parts of the ratio.
+*/
+ROJ_KERNEL_INLINE void calc_ratio (int a_length, const roj_real* __restrict__ a_slot, const roj_real* __restrict__ a_y,
+				   const roj_real* __restrict__ a_inv, roj_real* __restrict__ a_re, roj_real* __restrict__ a_im){
+
+  for(int k=0; k<a_length; k++){
+    roj_real sr = a_slot[2*k];
+    roj_real si = a_slot[2*k+1];
+    roj_real yr = a_y[2*k];
+    roj_real yi = a_y[2*k+1];
+
+    a_re[k] = (sr*yr + si*yi) * a_inv[k];
+    a_im[k] = (si*yr - sr*yi) * a_inv[k];
+  }
+}
+
+/**
+* @type: function
+* @brief: This routine calculates all requested estimates of a line. Values are calculated unconditionally and the ROJ_NO_ESTIMATE sentinel is selected afterwards, so loops have no branches.
+*
+* @param [in] a_length: A line length.
+* @param [in] a_buffers: Kernel buffers.
+* @param [in] a_lines: Slots of the line.
+* @param [out] a_maps: Estimates of the line.
+* @param [in] a_freq: Frequency of the first pixel (IF offset).
+* @param [in] a_step: Frequency step between pixels.
+* @param [in] a_scale: A scale of energy.
+*/
+ROJ_KERNEL_INLINE void calc_line (int a_length, roj_real** a_buffers, roj_estimator_lines a_lines, roj_estimator_maps a_maps, roj_real a_freq, roj_real a_step, roj_real a_scale){
+
+  const roj_real two_pi = TWO_PI;
+  roj_real* __restrict__ inv = a_buffers[ROJ_ROW_INV];
+  roj_real* __restrict__ d_re = a_buffers[ROJ_ROW_D];
+  roj_real* __restrict__ d_im = a_buffers[ROJ_ROW_D+1];
+  roj_real* __restrict__ d2_re = a_buffers[ROJ_ROW_D2];
+  roj_real* __restrict__ d2_im = a_buffers[ROJ_ROW_D2+1];
+  roj_real* __restrict__ t_re = a_buffers[ROJ_ROW_T];
+  roj_real* __restrict__ t_im = a_buffers[ROJ_ROW_T+1];
+  roj_real* __restrict__ t2_re = a_buffers[ROJ_ROW_T2];
+  roj_real* __restrict__ t2_im = a_buffers[ROJ_ROW_T2+1];
+  roj_real* __restrict__ dt_re = a_buffers[ROJ_ROW_DT];
+  roj_real* __restrict__ dt_im = a_buffers[ROJ_ROW_DT+1];
+
+  bool need_d = a_maps.ifreq_1 or a_maps.ifreq_2 or a_maps.k_rate or a_maps.dof or a_maps.d_rate or a_maps.f_rate;
+  bool need_t = a_maps.ifreq_2 or a_maps.delay or a_maps.k_rate or a_maps.dof or a_maps.d_rate or a_maps.f_rate;
+
+  /* inverse of squared magnitude replaces cabs(y)==0 test, 
+     it is shared by all outputs (energy is its scaled inverse) */
+  const roj_real* y = (const roj_real*)a_lines.y;
+  roj_real* __restrict__ energy = a_maps.energy;
+  
+  if((need_d or need_t) and energy){
+    for(int k=0; k<a_length; k++){
+      roj_real norm = y[2*k]*y[2*k] + y[2*k+1]*y[2*k+1];
+      roj_real value = 1 / norm;
+      inv[k] = norm==0 ? 0 : value;
+      energy[k] = norm * a_scale;
+    }
+  }
+  else if(need_d or need_t){
+    for(int k=0; k<a_length; k++){
+      roj_real norm = y[2*k]*y[2*k] + y[2*k+1]*y[2*k+1];
+      roj_real value = 1 / norm;
+      inv[k] = norm==0 ? 0 : value;
+    }
+  }
+  else if(energy){
+    for(int k=0; k<a_length; k++)
+      energy[k] = (y[2*k]*y[2*k] + y[2*k+1]*y[2*k+1]) * a_scale;
+  }
+
+  /* ratios to y in split arrays */
+  if(need_d)
+    calc_ratio(a_length, (const roj_real*)a_lines.yD, y, inv, d_re, d_im);
+  if(need_t)
+    calc_ratio(a_length, (const roj_real*)a_lines.yT, y, inv, t_re, t_im);
+  if(a_maps.d_rate)
+    calc_ratio(a_length, (const roj_real*)a_lines.yD2, y, inv, d2_re, d2_im);
+  if(a_maps.d_rate or a_maps.f_rate)
+    calc_ratio(a_length, (const roj_real*)a_lines.yDT, y, inv, dt_re, dt_im);
+  if(a_maps.f_rate)
+    calc_ratio(a_length, (const roj_real*)a_lines.yT2, y, inv, t2_re, t2_im);
+
+  /* streaming loops over split arrays */
+  if(a_maps.ifreq_1){
+    roj_real* __restrict__ out = a_maps.ifreq_1;
+    for(int k=0; k<a_length; k++){
+      roj_real value = a_freq + a_step*k - d_im[k] / two_pi;
+      out[k] = inv[k]==0 ? ROJ_NO_ESTIMATE : value;
+    }
+  }
+
+  if(a_maps.ifreq_2){
+    roj_real* __restrict__ out = a_maps.ifreq_2;
+    for(int k=0; k<a_length; k++){
+      roj_real value = a_freq + a_step*k - (d_re[k]*t_re[k] + d_im[k]*t_im[k]) / t_im[k] / two_pi;
+      out[k] = inv[k]==0 ? ROJ_NO_ESTIMATE : value;
+    }
+  }
+
+  if(a_maps.delay){
+    roj_real* __restrict__ out = a_maps.delay;
+    for(int k=0; k<a_length; k++)
+      out[k] = inv[k]==0 ? ROJ_NO_ESTIMATE : t_re[k];
+  }
+
+  if(a_maps.k_rate){
+    roj_real* __restrict__ out = a_maps.k_rate;
+    for(int k=0; k<a_length; k++){
+      roj_real value = d_re[k] / two_pi / t_im[k];
+      out[k] = inv[k]==0 ? ROJ_NO_ESTIMATE : value;
+    }
+  }
+
+  if(a_maps.dof){
+    roj_real* __restrict__ out = a_maps.dof;
+    for(int k=0; k<a_length; k++){
+      roj_real value = fabs(d_re[k] / two_pi * t_im[k]);
+      out[k] = inv[k]==0 ? ROJ_NO_ESTIMATE : value;
+    }
+  }
+
+  if(a_maps.d_rate){
+    roj_real* __restrict__ out = a_maps.d_rate;
+    for(int k=0; k<a_length; k++){
+      roj_real nominative = (d2_re[k] - d_re[k]*d_re[k] + d_im[k]*d_im[k]) / two_pi;
+      roj_real denominative = dt_im[k] - d_re[k]*t_im[k] - d_im[k]*t_re[k];
+      roj_real value = nominative / denominative;
+      out[k] = inv[k]==0 ? ROJ_NO_ESTIMATE : value;
+    }
+  }
+
+  if(a_maps.f_rate){
+    roj_real* __restrict__ out = a_maps.f_rate;
+    for(int k=0; k<a_length; k++){
+      roj_real nominative = (dt_im[k] - d_re[k]*t_im[k] - d_im[k]*t_re[k]) / two_pi;
+      roj_real denominative = t2_re[k] - t_re[k]*t_re[k] + t_im[k]*t_im[k];
+      roj_real value = -nominative / denominative;
+      out[k] = inv[k]==0 ? ROJ_NO_ESTIMATE : value;
+    }
+  }
+
+  /* m estimator uses ratios to yD and yT */
+  if(a_maps.m_rate){
+    const roj_real* __restrict__ yD = (const roj_real*)a_lines.yD;
+    const roj_real* __restrict__ yD2 = (const roj_real*)a_lines.yD2;
+    const roj_real* __restrict__ yT = (const roj_real*)a_lines.yT;
+    const roj_real* __restrict__ yT2 = (const roj_real*)a_lines.yT2;
+    roj_real* __restrict__ out = a_maps.m_rate;
+
+    for(int k=0; k<a_length; k++){
+      roj_real norm_d = yD[2*k]*yD[2*k] + yD[2*k+1]*yD[2*k+1];
+      roj_real norm_t = yT[2*k]*yT[2*k] + yT[2*k+1]*yT[2*k+1];
+      roj_real norm_t2 = yT2[2*k]*yT2[2*k] + yT2[2*k+1]*yT2[2*k+1];
+
+      roj_real nominative = (yD2[2*k]*yD[2*k] + yD2[2*k+1]*yD[2*k+1]) / norm_d / two_pi;
+      roj_real denominative = (yT2[2*k+1]*yT[2*k] - yT2[2*k]*yT[2*k+1]) / norm_t;
+      roj_real value = nominative / denominative;
+      out[k] = (norm_d==0 or norm_t==0 or norm_t2==0) ? ROJ_NO_ESTIMATE : value;
+    }
+  }
+}
+
+/* instruction set variants */
+
+#ifdef ROJ_KERNEL_DISPATCH
+__attribute__((target("avx512f,avx512dq"), optimize("tree-vectorize")))
+static void calc_line_avx512 (int a_length, roj_real** a_buffers, roj_estimator_lines a_lines, roj_estimator_maps a_maps, roj_real a_freq, roj_real a_step, roj_real a_scale){
+
+  calc_line(a_length, a_buffers, a_lines, a_maps, a_freq, a_step, a_scale);
+}
+
+__attribute__((target("avx2,fma"), optimize("tree-vectorize")))
+static void calc_line_avx2 (int a_length, roj_real** a_buffers, roj_estimator_lines a_lines, roj_estimator_maps a_maps, roj_real a_freq, roj_real a_step, roj_real a_scale){
+
+  calc_line(a_length, a_buffers, a_lines, a_maps, a_freq, a_step, a_scale);
+}
+#endif
+
+__attribute__((optimize("tree-vectorize")))
+static void calc_line_generic (int a_length, roj_real** a_buffers, roj_estimator_lines a_lines, roj_estimator_maps a_maps, roj_real a_freq, roj_real a_step, roj_real a_scale){
+
+  calc_line(a_length, a_buffers, a_lines, a_maps, a_freq, a_step, a_scale);
+}
+
+/* ************************************************************************************************************************* */
+/**
+* @type: constructor
+* @brief: This is a constructor of roj_estimator_kernel. It allocates aligned buffers for one line.
+*
+* @param [in] a_length: A line length (STFT height or number of samples of a channel).
+*/
+roj_estimator_kernel :: roj_estimator_kernel (int a_length){
+
+  if(a_length<1){
+    call_warning("in roj_estimator_kernel :: roj_estimator_kernel");
+    call_error("length < 1");
+  }
+
+  m_length = a_length;
+  m_buffers = allocate_real_rows(ROJ_ROWS, m_length);
+}
+
+/**
+* @type: destructor
+* @brief: This is a kernel destructor.
+*/
+roj_estimator_kernel :: ~roj_estimator_kernel (){
+
+  release_rows(m_buffers);
+}
+
+/* ************************************************************************************************************************* */
+/**
+* @type: method
+* @brief: This function calculates requested estimates of a line in one call, so the inverse of y and ratios of slots are shared by all outputs. Each output is a contiguous array of the line length. Pixels for which y (or yD, yT and yT2 for the m estimator) is zero are set to ROJ_NO_ESTIMATE.
+*
+* @param [in] a_lines: Slots of the line.
+* @param [out] a_maps: Estimates of the line (NULL pointers are skipped).
+* @param [in] a_freq (default 0): Frequency of the first pixel, it is added to IF estimates.
+* @param [in] a_step (default 0): Frequency step between pixels.
+* @param [in] a_scale (default 1): A scale of energy (squared magnitude of y).
+*/
+void roj_estimator_kernel :: calc (roj_estimator_lines a_lines, roj_estimator_maps a_maps, double a_freq, double a_step, double a_scale){
+
+  bool need_y = a_maps.energy or a_maps.ifreq_1 or a_maps.ifreq_2 or a_maps.delay or a_maps.k_rate or a_maps.dof or a_maps.d_rate or a_maps.f_rate;
+  bool need_d = a_maps.ifreq_1 or a_maps.ifreq_2 or a_maps.k_rate or a_maps.dof or a_maps.d_rate or a_maps.f_rate or a_maps.m_rate;
+  bool need_t = a_maps.ifreq_2 or a_maps.delay or a_maps.k_rate or a_maps.dof or a_maps.d_rate or a_maps.f_rate or a_maps.m_rate;
+
+  if((need_y and a_lines.y==NULL) or (need_d and a_lines.yD==NULL) or (need_t and a_lines.yT==NULL) or
+     ((a_maps.d_rate or a_maps.m_rate) and a_lines.yD2==NULL) or
+     ((a_maps.f_rate or a_maps.m_rate) and a_lines.yT2==NULL) or
+     ((a_maps.d_rate or a_maps.f_rate) and a_lines.yDT==NULL)){
+    call_warning("in roj_estimator_kernel :: calc");
+    call_error("required slot is null");
+  }
+
+#ifdef ROJ_KERNEL_DISPATCH
+  if(__builtin_cpu_supports("avx512f") and __builtin_cpu_supports("avx512dq"))
+    calc_line_avx512(m_length, m_buffers, a_lines, a_maps, a_freq, a_step, a_scale);
+  else if(__builtin_cpu_supports("avx2") and __builtin_cpu_supports("fma"))
+    calc_line_avx2(m_length, m_buffers, a_lines, a_maps, a_freq, a_step, a_scale);
+  else
+#endif
+    calc_line_generic(m_length, m_buffers, a_lines, a_maps, a_freq, a_step, a_scale);
+}
+
+/**
+* @type: method
+* @brief: This function returns a name of the instruction set used by kernels.
+*
+* @return: "avx512", "avx2" or "generic".
+*/
+const char* roj_estimator_kernel :: get_isa (){
+
+#ifdef ROJ_KERNEL_DISPATCH
+  if(__builtin_cpu_supports("avx512f") and __builtin_cpu_supports("avx512dq"))
+    return "avx512";
+  if(__builtin_cpu_supports("avx2") and __builtin_cpu_supports("fma"))
+    return "avx2";
+#endif
+  return "generic";
+}
@@ -0,0 +1,101 @@
+/* *************************************************** *
+ * This file is a part of ccROJ project (version 0-49) *
+ * distributed under GNU General Public License v3.0.  *
+ * Please visit the webpage: github.com/dsp-box/ccROJ  *
+ * for more information.                               *
+ *                       contact: Krzysztof Czarnecki  *
+ *                email: czarnecki.krzysiek@gmail.com  *
+ * *************************************************** */
+
+#ifndef _roj_estim_kernel_
+#define _roj_estim_kernel_
+
+/**
+* @type: class
+* @brief: Definition of roj_estimator_kernel class. It calculates IF, delay and chirp-rate estimates for a line of pixels (an STFT column or a filter channel). Ratios of slots are calculated once and stored in split real and imaginary arrays, then each estimate is obtained by a streaming loop. AVX-512 and AVX2 versions are selected at runtime.
+*/
+
+/* ************************************************************************************************************************* */
+/* headers and declarations */
+
+#include "roj-external.hh"
+#include "roj-misc.hh"
+
+#include "roj-real-matrix.hh"
+class roj_real_matrix;
+
+/* ************************************************************************************************************************* */
+/* structure definitions */
+
+/**
+* @type: struct
+* @brief: This structure contains pointers to slots of a line: y - window, yD - window derivative, yD2 - second derivative, yT - time-ramped window, yT2 - second ramp, yDT - ramped derivative. Unused slots can be NULL.
+*/
+struct roj_estimator_lines{
+
+  roj_complex* y;
+  roj_complex* yD;
+  roj_complex* yD2;
+  roj_complex* yT;
+  roj_complex* yT2;
+  roj_complex* yDT;
+};
+
+/**
+* @type: struct
+* @brief: This structure contains pointers to output estimates of a line. Estimates with NULL pointers are not calculated.
+*/
+struct roj_estimator_maps{
+
+  roj_real* energy;
+  roj_real* ifreq_1;
+  roj_real* ifreq_2;
+  roj_real* delay;
+  roj_real* k_rate;
+  roj_real* m_rate;
+  roj_real* d_rate;
+  roj_real* f_rate;
+  roj_real* dof;
+};
+
+/**
+* @type: struct
+* @brief: This structure contains pointers to output distributions of an analyzer. Distributions with NULL pointers are not calculated.
+*/
+struct roj_estimator_images{
+
+  roj_real_matrix* energy;
+  roj_real_matrix* ifreq_1;
+  roj_real_matrix* ifreq_2;
+  roj_real_matrix* delay;
+  roj_real_matrix* k_rate;
+  roj_real_matrix* m_rate;
+  roj_real_matrix* d_rate;
+  roj_real_matrix* f_rate;
+  roj_real_matrix* dof;
+};
+
+/* ************************************************************************************************************************* */
+/* kernel class definition */
+
+class roj_estimator_kernel{
+private:
+
+  /* line length */
+  int m_length;
+
+  /* squared magnitude of y and split ratios to y */
+  roj_real** m_buffers;
+
+public:
+
+  /* construction */
+  roj_estimator_kernel(int);
+  ~roj_estimator_kernel();
+
+  /* calculation */
+  void calc(roj_estimator_lines, roj_estimator_maps, double =0, double =0, double =1);
+  static const char* get_isa();
+};
+
+#endif
@@ -21,7 +21,9 @@
 
 #include <sndfile.h>
 #include <time.h>
+#include <pthread.h>
 
 #include <map>
+#include <vector>
 
 #endif
@@ -24,51 +24,47 @@ roj_fft_analyzer :: roj_fft_analyzer (roj_array_config a_bank_conf, roj_window_g
 /* ************************************************************************************************************************* */
 /**
 * @type: private
-* @brief: This routine roj_calculate short-time Fourier transform (STFT).
+* @brief: This routine prepares the window generator for a given STFT column. The window does not depend on time, so it is never changed.
 *
-* @param [in] a_d_order: An order of window derivative with respect to time.
-* @param [in] a_t_order: An order of power of timeramp which is multiplied by the window waveform.
+* @param [in] a_column: An index of STFT column.
+* @param [in] a_window_gen: A pointer to the used window generator.
 *
-* @return: A pointer to the resultant STFT.
+* @return: False, since the window is not changed.
 */
-complex double ** roj_fft_analyzer :: transforming (int a_d_order, int a_t_order){
+bool roj_fft_analyzer :: update_window (int a_column, roj_window_generator* a_window_gen){
 
-  /* allocate memory for stft */
-  complex double** stft =  allocate_stft();
-  
-  /* tmp signal for fft - only length is used */
-  roj_signal_config sig_conf;
-  sig_conf.length = m_bank_config.length;
-  sig_conf.rate = 1; /* not used here, however checked */
-    
-  roj_complex_signal* in_tmp = new roj_complex_signal(sig_conf);
-  int start_index = (m_bank_config.length-m_window_gen->get_length()) / 2;
+  return false;
+}
 
-  int byte_size_win = m_window_gen->get_length() * sizeof(complex double);
-  int byte_size_out = get_height() * sizeof(complex double);
+/**
+* @type: private
+* @brief: This routine checks if windows of given slots are real (e.g. the chirp-rate of the window generator is 0). Then r2c transforms can be used for real signals.
+*
+* @param [in] a_codes: Codes of slots (window derivative order and time-ramp order).
+*
+* @return: True if all windows are real.
+*/
+bool roj_fft_analyzer :: check_real_windows (std::vector<std::pair<int, int> > a_codes){
 
-  /* get window waveform */
-  roj_complex_signal* window_waveform = m_window_gen->get_window(a_d_order, a_t_order);
-  int initial = get_initial ();
-  
-  /* calculating spectra by fft */
-  for(int n=0; n<get_width();n++){
-    in_tmp->clear();
+  for(unsigned int s=0; s<a_codes.size(); s++){
+    roj_complex_signal* window = m_window_gen->get_window(a_codes[s].first, a_codes[s].second);
+    bool imag = window->check_imag();
+    delete window;
     
-    int curr_index = n*m_hop;
-    memcpy(&in_tmp->m_waveform[start_index], &m_input_signal->m_waveform[curr_index], byte_size_win);
-    for(int m=0; m<m_window_gen->get_length(); m++)
-      in_tmp->m_waveform[start_index+m] *= window_waveform->m_waveform[m];
-
-    roj_fourier_spectrum* out_tmp = in_tmp->get_spectrum();
-    memcpy(stft[n], &out_tmp->m_spectrum[initial], byte_size_out);
-    delete out_tmp;
-
-    print_progress(n+1, get_width(), "stft");
+    if(imag)
+      return false;
   }
+  
+  return true;
+}
+
+/**
+* @type: private
+* @brief: This routine checks if windows are the same for all columns. It is true for this analyzer.
+*
+* @return: True.
+*/
+bool roj_fft_analyzer :: check_fixed_windows (){
 
-  print_progress(0, 0, "stft");  
-  delete window_waveform;
-  delete in_tmp;
-  return stft;
+  return true;
 }
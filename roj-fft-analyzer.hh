@@ -33,8 +33,10 @@ class roj_fft_analyzer
 
 private:
 
-  /* calc stft */
-  complex double ** transforming(int, int);
+  /* window is the same for each column */
+  bool update_window(int, roj_window_generator*);
+  bool check_real_windows(std::vector<std::pair<int, int> >);
+  bool check_fixed_windows();
   
 public:
 
@@ -0,0 +1,349 @@
+/* *************************************************** *
+ * This file is a part of ccROJ project (version 0-49) *
+ * distributed under GNU General Public License v3.0.  *
+ * Please visit the webpage: github.com/dsp-box/ccROJ  *
+ * for more information.                               *
+ *                       contact: Krzysztof Czarnecki  *
+ *                email: czarnecki.krzysiek@gmail.com  *
+ * *************************************************** */
+
+#include "roj-fft-plan.hh"
+
+/* ************************************************************************************************************************* */
+/* static fields */
+
+std::map<roj_plan_key, roj_fftw(plan)> roj_fft_plan_cache :: m_plans;
+unsigned int roj_fft_plan_cache :: m_flags = FFTW_ESTIMATE;
+pthread_mutex_t roj_fft_plan_cache :: m_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+/* ************************************************************************************************************************* */
+/**
+* @type: operator
+* @brief: Overloading of '<' operator. It is required by std::map.
+*
+* @param [in] a_key: A compared key.
+*
+* @return: True if this key precedes the given key.
+*/
+bool roj_plan_key :: operator < (const roj_plan_key& a_key) const{
+
+  if(length != a_key.length)
+    return length < a_key.length;
+  if(howmany != a_key.howmany)
+    return howmany < a_key.howmany;
+  if(sign != a_key.sign)
+    return sign < a_key.sign;
+  if(real != a_key.real)
+    return real < a_key.real;
+  if(in_place != a_key.in_place)
+    return in_place < a_key.in_place;
+  return aligned < a_key.aligned;
+}
+
+/* ************************************************************************************************************************* */
+/**
+* @type: private
+* @brief: This routine creates a new plan. Temporary buffers are used, so FFTW_MEASURE and FFTW_PATIENT planning does not overwrite any user data. Transforms of a batch are placed one after another.
+*
+* @param [in] a_key: A configuration of the plan.
+*
+* @return: The created plan.
+*/
+roj_fftw(plan) roj_fft_plan_cache :: create_plan (roj_plan_key a_key){
+
+  unsigned int flags = m_flags;
+  if(!a_key.aligned)
+    flags |= FFTW_UNALIGNED;
+
+  int length = a_key.length;
+  int size = a_key.length * a_key.howmany;
+  roj_fftw(plan) pl;
+
+  if(a_key.real){
+
+    /* r2c plan produces length/2+1 lines for each transform */
+    int half = length/2 + 1;
+    roj_real* in_tmp = roj_fftw(alloc_real)(size);
+    roj_complex* out_tmp = roj_fftw(alloc_complex)(half * a_key.howmany);
+
+    pl = roj_fftw(plan_many_dft_r2c)(1, &length, a_key.howmany,
+				in_tmp, NULL, 1, length,
+				out_tmp, NULL, 1, half,
+				flags);
+    roj_fftw(free)(out_tmp);
+    roj_fftw(free)(in_tmp);
+  }
+  else{
+
+    roj_complex* in_tmp = roj_fftw(alloc_complex)(size);
+    roj_complex* out_tmp = in_tmp;
+    if(!a_key.in_place)
+      out_tmp = roj_fftw(alloc_complex)(size);
+
+    if(a_key.howmany == 1)
+      pl = roj_fftw(plan_dft_1d)(length, in_tmp, out_tmp, a_key.sign, flags);
+    else
+      pl = roj_fftw(plan_many_dft)(1, &length, a_key.howmany,
+			      in_tmp, NULL, 1, length,
+			      out_tmp, NULL, 1, length,
+			      a_key.sign, flags);
+
+    if(!a_key.in_place)
+      roj_fftw(free)(out_tmp);
+    roj_fftw(free)(in_tmp);
+  }
+  
+  if(pl == NULL){
+    call_warning("in roj_fft_plan_cache :: create_plan");
+    call_error("plan cannot be created");
+  }
+
+  return pl;
+}
+
+/**
+* @type: private
+* @brief: This routine returns a cached plan for a given key. The plan is created if it is not found.
+*
+* @param [in] a_key: A configuration of the plan.
+*
+* @return: The cached plan.
+*/
+roj_fftw(plan) roj_fft_plan_cache :: find_plan (roj_plan_key a_key){
+
+  pthread_mutex_lock(&m_mutex);
+
+  roj_fftw(plan) pl;
+  std::map<roj_plan_key, roj_fftw(plan)>::iterator i = m_plans.find(a_key);
+  if(i != m_plans.end())
+    pl = i->second;
+  else{
+    pl = create_plan(a_key);
+    m_plans[a_key] = pl;
+  }
+  
+  pthread_mutex_unlock(&m_mutex);
+  return pl;
+}
+
+/* ************************************************************************************************************************* */
+/**
+* @type: method
+* @brief: This routine returns a plan suitable for given buffers. The plan is created only if it is not found in the cache. The returned plan has to be executed by fftw_execute_dft and it must not be destroyed.
+*
+* @param [in] a_length: A transform length.
+* @param [in] a_sign: A transform direction (FFTW_FORWARD or FFTW_BACKWARD).
+* @param [in] a_in: A pointer to input samples.
+* @param [in] a_out: A pointer to output samples.
+* @param [in] a_howmany (default 1): A number of transforms stored contiguously in the buffers.
+*
+* @return: The cached plan.
+*/
+roj_fftw(plan) roj_fft_plan_cache :: get_plan (unsigned int a_length, int a_sign, roj_complex* a_in, roj_complex* a_out, unsigned int a_howmany){
+
+  if(a_length<1){
+    call_warning("in roj_fft_plan_cache :: get_plan");
+    call_error("length < 1");
+  }
+
+  if(a_howmany<1){
+    call_warning("in roj_fft_plan_cache :: get_plan");
+    call_error("howmany < 1");
+  }
+
+  if(a_sign!=FFTW_FORWARD and a_sign!=FFTW_BACKWARD){
+    call_warning("in roj_fft_plan_cache :: get_plan");
+    call_error("unknown transform direction");
+  }
+
+  roj_plan_key key;
+  key.length = a_length;
+  key.howmany = a_howmany;
+  key.sign = a_sign;
+  key.real = false;
+  key.in_place = a_in == a_out;
+  key.aligned = roj_fftw(alignment_of)((roj_real*)a_in) == 0 and roj_fftw(alignment_of)((roj_real*)a_out) == 0;
+
+  return find_plan(key);
+}
+
+/**
+* @type: method
+* @brief: This routine executes a cached plan on given buffers.
+*
+* @param [in] a_length: A transform length.
+* @param [in] a_sign: A transform direction (FFTW_FORWARD or FFTW_BACKWARD).
+* @param [in] a_in: A pointer to input samples.
+* @param [out] a_out: A pointer to output samples (it can be equal to a_in).
+* @param [in] a_howmany (default 1): A number of transforms stored contiguously in the buffers.
+*/
+void roj_fft_plan_cache :: execute (unsigned int a_length, int a_sign, roj_complex* a_in, roj_complex* a_out, unsigned int a_howmany){
+
+  roj_fftw(plan) pl = get_plan(a_length, a_sign, a_in, a_out, a_howmany);
+  roj_fftw(execute_dft)(pl, a_in, a_out);
+}
+
+/**
+* @type: method
+* @brief: This routine returns a forward real-to-complex (r2c) plan suitable for given buffers. Only length/2+1 lines of each transform are produced, the remaining ones follow from Hermitian symmetry. The returned plan has to be executed by fftw_execute_dft_r2c and it must not be destroyed.
+*
+* @param [in] a_length: A transform length.
+* @param [in] a_in: A pointer to real input samples.
+* @param [in] a_out: A pointer to output lines (length/2+1 for each transform).
+* @param [in] a_howmany (default 1): A number of transforms stored contiguously in the buffers.
+*
+* @return: The cached plan.
+*/
+roj_fftw(plan) roj_fft_plan_cache :: get_r2c_plan (unsigned int a_length, roj_real* a_in, roj_complex* a_out, unsigned int a_howmany){
+
+  if(a_length<1){
+    call_warning("in roj_fft_plan_cache :: get_r2c_plan");
+    call_error("length < 1");
+  }
+
+  if(a_howmany<1){
+    call_warning("in roj_fft_plan_cache :: get_r2c_plan");
+    call_error("howmany < 1");
+  }
+
+  if((void*)a_in == (void*)a_out){
+    call_warning("in roj_fft_plan_cache :: get_r2c_plan");
+    call_error("in-place r2c transform is not supported");
+  }
+  
+  roj_plan_key key;
+  key.length = a_length;
+  key.howmany = a_howmany;
+  key.sign = FFTW_FORWARD;
+  key.real = true;
+  key.in_place = false;
+  key.aligned = roj_fftw(alignment_of)(a_in) == 0 and roj_fftw(alignment_of)((roj_real*)a_out) == 0;
+
+  return find_plan(key);
+}
+
+/**
+* @type: method
+* @brief: This routine executes a cached r2c plan on given buffers.
+*
+* @param [in] a_length: A transform length.
+* @param [in] a_in: A pointer to real input samples.
+* @param [out] a_out: A pointer to output lines (length/2+1 for each transform).
+* @param [in] a_howmany (default 1): A number of transforms stored contiguously in the buffers.
+*/
+void roj_fft_plan_cache :: execute_r2c (unsigned int a_length, roj_real* a_in, roj_complex* a_out, unsigned int a_howmany){
+
+  roj_fftw(plan) pl = get_r2c_plan(a_length, a_in, a_out, a_howmany);
+  roj_fftw(execute_dft_r2c)(pl, a_in, a_out);
+}
+
+/* ************************************************************************************************************************* */
+/**
+* @type: method
+* @brief: This routine sets the planning rigor. All cached plans are released, so new plans will be created with the new flags.
+*
+* @param [in] a_flags: FFTW_ESTIMATE (default), FFTW_MEASURE, FFTW_PATIENT or FFTW_EXHAUSTIVE.
+*/
+void roj_fft_plan_cache :: set_planning (unsigned int a_flags){
+
+  if(a_flags!=FFTW_ESTIMATE and a_flags!=FFTW_MEASURE and
+     a_flags!=FFTW_PATIENT and a_flags!=FFTW_EXHAUSTIVE){
+    call_warning("in roj_fft_plan_cache :: set_planning");
+    call_error("unknown planning flags");
+  }
+
+  if(a_flags != m_flags)
+    clear();
+  m_flags = a_flags;
+}
+
+/**
+* @type: method
+* @brief: This routine returns the planning rigor.
+*
+* @return: FFTW planning flags.
+*/
+unsigned int roj_fft_plan_cache :: get_planning (){
+
+  return m_flags;
+}
+
+/**
+* @type: method
+* @brief: This routine returns the number of cached plans.
+*
+* @return: The number of plans.
+*/
+unsigned int roj_fft_plan_cache :: get_size (){
+
+  return m_plans.size();
+}
+
+/**
+* @type: method
+* @brief: This routine destroys all cached plans.
+*/
+void roj_fft_plan_cache :: clear (){
+
+  pthread_mutex_lock(&m_mutex);
+
+  std::map<roj_plan_key, roj_fftw(plan)>::iterator i = m_plans.begin();
+  for ( ; i != m_plans.end(); ++i)
+    roj_fftw(destroy_plan)(i->second);
+
+  m_plans.clear();
+  pthread_mutex_unlock(&m_mutex);
+}
+
+/* ************************************************************************************************************************* */
+/**
+* @type: method
+* @brief: This routine loads FFTW wisdom from a file. It should be called before any plan is created.
+*
+* @param [in] a_fname: Name of a wisdom file.
+*
+* @return: True if wisdom is imported, false otherwise.
+*/
+bool roj_fft_plan_cache :: import_wisdom (const char* a_fname){
+
+  if(a_fname==NULL){
+    call_warning("in roj_fft_plan_cache :: import_wisdom");
+    call_error("arg is null");
+  }
+
+  if(!roj_fftw(import_wisdom_from_filename)(a_fname)){
+    call_warning("wisdom cannot be imported");
+    return false;
+  }
+
+#ifdef ROJ_DEBUG_ON
+  call_info("load wisdom: ", (char*)a_fname);
+#endif
+  return true;
+}
+
+/**
+* @type: method
+* @brief: This routine saves the accumulated FFTW wisdom to a file.
+*
+* @param [in] a_fname: Name of a wisdom file.
+*
+* @return: True if wisdom is exported, false otherwise.
+*/
+bool roj_fft_plan_cache :: export_wisdom (const char* a_fname){
+
+  if(a_fname==NULL){
+    call_warning("in roj_fft_plan_cache :: export_wisdom");
+    call_error("arg is null");
+  }
+
+  if(!roj_fftw(export_wisdom_to_filename)(a_fname)){
+    call_warning("wisdom cannot be exported");
+    return false;
+  }
+
+#ifdef ROJ_DEBUG_ON
+  call_info("save wisdom: ", (char*)a_fname);
+#endif
+  return true;
+}
@@ -0,0 +1,80 @@
+/* *************************************************** *
+ * This file is a part of ccROJ project (version 0-49) *
+ * distributed under GNU General Public License v3.0.  *
+ * Please visit the webpage: github.com/dsp-box/ccROJ  *
+ * for more information.                               *
+ *                       contact: Krzysztof Czarnecki  *
+ *                email: czarnecki.krzysiek@gmail.com  *
+ * *************************************************** */
+
+#ifndef _roj_fft_plan_
+#define _roj_fft_plan_
+
+/**
+* @type: class
+* @brief: Definition of roj_fft_plan_cache class. It is a process-wide store of FFTW plans. A plan is created once for a given transform configuration and it is reused by all analyzers, spectra and Hilbert equivalents. Plans can be executed concurrently on different buffers.
+*/
+
+/* ************************************************************************************************************************* */
+/* headers and declarations */
+
+#include "roj-external.hh"
+#include "roj-misc.hh"
+
+/* ************************************************************************************************************************* */
+/* structure definitions */
+
+/**
+* @type: struct
+* @brief: This is a key which identifies a cached plan (transform length, number of contiguous transforms, direction, real or complex input, in-place or out-of-place transform and memory alignment).
+*/
+struct roj_plan_key{
+
+  unsigned int length;
+  unsigned int howmany;
+  int sign;
+  bool real;
+  bool in_place;
+  bool aligned;
+
+  bool operator < (const roj_plan_key&) const;
+};
+
+/* ************************************************************************************************************************* */
+/* plan cache class definition */
+
+class roj_fft_plan_cache{
+private:
+
+  /* cached plans */
+  static std::map<roj_plan_key, roj_fftw(plan)> m_plans;
+
+  /* planning rigor */
+  static unsigned int m_flags;
+
+  /* planner is not thread-safe */
+  static pthread_mutex_t m_mutex;
+
+  static roj_fftw(plan) create_plan(roj_plan_key);
+  static roj_fftw(plan) find_plan(roj_plan_key);
+
+public:
+
+  /* plan access */
+  static roj_fftw(plan) get_plan(unsigned int, int, roj_complex*, roj_complex*, unsigned int =1);
+  static void execute(unsigned int, int, roj_complex*, roj_complex*, unsigned int =1);
+  static roj_fftw(plan) get_r2c_plan(unsigned int, roj_real*, roj_complex*, unsigned int =1);
+  static void execute_r2c(unsigned int, roj_real*, roj_complex*, unsigned int =1);
+
+  /* configuration */
+  static void set_planning(unsigned int);
+  static unsigned int get_planning();
+  static unsigned int get_size();
+  static void clear();
+
+  /* FFTW wisdom */
+  static bool import_wisdom(const char*);
+  static bool export_wisdom(const char*);
+};
+
+#endif
@@ -43,6 +43,9 @@ roj_filter_bank :: roj_filter_bank (roj_array_config a_bank_conf, roj_filter_gen
   /* copy filter generator and allocate memory */
   m_filter_gen = new roj_filter_generator(*a_filter_gen);   
   m_filter_array = new roj_filter* [m_config.length];
+  m_threads = 1;
+  m_decimation = false;
+  m_decimator = NULL;
 
   double delta = (m_config.max - m_config.min) / (m_config.length-1);
   if (m_config.length == 1)
@@ -67,6 +70,8 @@ roj_filter_bank :: ~roj_filter_bank (){
   for(int n=0; n<m_config.length; n++)
     delete m_filter_array[n];
   delete [] m_filter_array;
+
+  delete m_decimator;
 }
 
 /* ************************************************************************************************************************* */
@@ -118,6 +123,58 @@ double roj_filter_bank :: get_frequency(int a_index){
   return frequency;
 }
 
+/**
+ * @type: method
+ * @brief: This routine sets a number of worker threads which filter channels of the bank. Channels are independent, so they are distributed between threads.
+ *
+ * @param [in] a_threads (default 1): A number of threads.
+ */
+void roj_filter_bank :: set_threads (unsigned int a_threads){
+
+  if(a_threads<1){
+    call_warning("in roj_filter_bank :: set_threads");
+    call_error("number of threads < 1");
+  }
+  
+  m_threads = a_threads;
+}
+
+/**
+ * @type: method
+ * @brief: This routine switches the decimating mode. In this mode, signals filtered with hop>1 are processed by a decimator (see roj_ode_decimator), which calculates only the retained output samples. The decimator has its own states, which are separate from states of filters. The mode requires ODE filters without additional output delay.
+ *
+ * @param [in] a_decimation (default true): True if the decimating mode is used.
+ */
+void roj_filter_bank :: set_decimation (bool a_decimation){
+
+  if(a_decimation and m_filter_gen->get_type()!=ROJ_ODE_FILTER){
+    call_warning("in roj_filter_bank :: set_decimation");
+    call_error("decimation requires ODE filters");
+  }
+
+  if(a_decimation and m_filter_gen->get_delay()!=1){
+    call_warning("in roj_filter_bank :: set_decimation");
+    call_error("decimation requires filters without output delay");
+  }
+
+  /* decimator is created when it is needed for the first time */
+  if(a_decimation and m_decimator==NULL)
+    m_decimator = m_filter_gen->get_ode_decimator(m_config);
+
+  m_decimation = a_decimation;
+}
+
+/**
+ * @type: method
+ * @brief: This routine returns true if the decimating mode is used.
+ *
+ * @return: The decimating mode flag.
+ */
+bool roj_filter_bank :: get_decimation (){
+
+  return m_decimation;
+}
+
 /* ************************************************************************************************************************* */
 /**
  * @type: method
@@ -133,7 +190,7 @@ void roj_filter_bank :: filtering (complex double a_sample){
 
 /**
  * @type: method
- * @brief: This routine performs filtering operation (the whole signal).
+ * @brief: This routine performs filtering operation (the whole signal). Channels are processed by worker threads (see set_threads).
  *
  * @param [in] a_sample: An signal for filtering.
  * @param [in] a_hop (default 1): A hopsize.
@@ -142,20 +199,46 @@ void roj_filter_bank :: filtering (complex double a_sample){
  */
 roj_complex_signal** roj_filter_bank :: filtering (roj_complex_signal* a_sig, int a_hop){
 
+  roj_complex_signal** output = new roj_complex_signal* [m_config.length];
+
+  roj_filter_job job(a_sig, a_hop);
+  job.add_bank(this, output);
+  job.run(m_threads);
+
+  return output;
+}
+
+/**
+ * @type: method
+ * @brief: This routine filters the whole signal by a single channel. Channels have separate filter states, so different channels can be processed concurrently.
+ *
+ * @param [in] a_index: An index of the channel.
+ * @param [in] a_sig: An signal for filtering.
+ * @param [in] a_hop (default 1): A hopsize.
+ *
+ * @return: A pointer to the output filtered signal.
+ */
+roj_complex_signal* roj_filter_bank :: filter_channel (int a_index, roj_complex_signal* a_sig, int a_hop){
+
   /* args checking */
   if(a_hop<1){
-    call_warning("in roj_filter_bank :: filtering");
+    call_warning("in roj_filter_bank :: filter_channel");
     call_error("hop<1");
   }
 
   if(a_sig == NULL){
-    call_warning("in roj_filter_bank :: filtering");
+    call_warning("in roj_filter_bank :: filter_channel");
     call_error("sig is NULL");
   }
 
+  if(a_index<0 or a_index>=m_config.length){
+    call_warning("in roj_filter_bank :: filter_channel");
+    call_error("wrong index");
+  }
+
   roj_signal_config in_conf = a_sig->get_config();
   if(in_conf.rate != m_filter_gen->get_rate()){
-    call_warning("in roj_filter_bank :: filtering");    
+    call_warning("in roj_filter_bank :: filter_channel");    
     call_error("rates are not equal");
   }
 
@@ -164,21 +247,162 @@ roj_complex_signal** roj_filter_bank :: filtering (roj_complex_signal* a_sig, in
   out_conf.length = in_conf.length / a_hop;
   out_conf.start = in_conf.start + (double)(a_hop-1) / in_conf.rate;
   
-  roj_complex_signal** output = new roj_complex_signal* [m_config.length];
-  for(int k=0; k<m_config.length; k++){
-    output[k] = new roj_complex_signal(out_conf);
+  roj_complex_signal* output = new roj_complex_signal(out_conf);
+  roj_filter* filter = m_filter_array[a_index];
     
-    for(int n=0; n<in_conf.length; n++){
+  for(int n=0; n<in_conf.length; n++){
 
-      m_filter_array[k]->process(a_sig->m_waveform[n]);
+    filter->process(a_sig->m_waveform[n]);
       
-      if(n%a_hop == a_hop-1)
-	output[k]->m_waveform[n/a_hop] = m_filter_array[k]->get_output();       
-    }
-    
-    print_progress(k+1, m_config.length, "filtering");
+    if(n%a_hop == a_hop-1)
+      output->m_waveform[n/a_hop] = filter->get_output();       
   }
-
-  print_progress(0, 0, "filtering");  
+  
   return output;
 }
+
+/**
+* @type: method
+* @brief: This routine filters a signal by consecutive channels together. Channels are processed by the vectorized engine (see roj_filter_lanes), and the result is the same as of filter_channel called for each channel.
+*
+* @param [in] a_first: An index of the first channel.
+* @param [in] a_count: A number of channels.
+* @param [in] a_sig: A signal for filtering.
+* @param [out] a_outputs: An array of output signals (one for each channel), which are created by this routine.
+* @param [in] a_hop (default 1): A hopsize.
+*/
+void roj_filter_bank :: filter_lanes (int a_first, int a_count, roj_complex_signal* a_sig, roj_complex_signal** a_outputs, int a_hop){
+
+  if(a_sig == NULL or a_outputs == NULL){
+    call_warning("in roj_filter_bank :: filter_lanes");
+    call_error("arg is null");
+  }
+
+  if(a_hop<1){
+    call_warning("in roj_filter_bank :: filter_lanes");
+    call_error("hop<1");
+  }
+
+  if(a_count<1){
+    call_warning("in roj_filter_bank :: filter_lanes");
+    call_error("wrong index");
+  }
+
+  roj_signal_config in_conf = a_sig->get_config();
+  roj_signal_config out_conf;
+  out_conf.rate = in_conf.rate / a_hop;
+  out_conf.length = in_conf.length / a_hop;
+  out_conf.start = in_conf.start + (double)(a_hop-1) / in_conf.rate;
+
+  roj_complex** waveforms = new roj_complex* [a_count];
+  for(int k=0; k<a_count; k++){
+    a_outputs[k] = new roj_complex_signal(out_conf);
+    waveforms[k] = a_outputs[k]->m_waveform;
+  }
+
+  filter_lanes(a_first, a_count, a_sig, waveforms, a_hop);
+  delete [] waveforms;
+}
+
+/**
+* @type: method
+* @brief: This routine filters a signal by consecutive channels together and stores outputs into given buffers. If the stride is a row length of a time-major matrix (see allocate_complex_rows), outputs of all channels of a time instant are stored side by side.
+*
+* @param [in] a_first: An index of the first channel.
+* @param [in] a_count: A number of channels.
+* @param [in] a_sig: A signal for filtering.
+* @param [out] a_outputs: Pointers to the first output sample of each channel (at least the signal length divided by hop samples).
+* @param [in] a_hop (default 1): A hopsize.
+* @param [in] a_stride (default 1): A distance between consecutive output samples of a channel.
+*/
+void roj_filter_bank :: filter_lanes (int a_first, int a_count, roj_complex_signal* a_sig, roj_complex** a_outputs, int a_hop, int a_stride){
+
+  /* args checking */
+  if(a_hop<1 or a_stride<1){
+    call_warning("in roj_filter_bank :: filter_lanes");
+    call_error("hop or stride < 1");
+  }
+
+  if(a_sig == NULL or a_outputs == NULL){
+    call_warning("in roj_filter_bank :: filter_lanes");
+    call_error("arg is null");
+  }
+
+  if(a_count<1 or a_first<0 or a_first+a_count>m_config.length){
+    call_warning("in roj_filter_bank :: filter_lanes");
+    call_error("wrong index");
+  }
+
+  roj_signal_config in_conf = a_sig->get_config();
+  if(in_conf.rate != m_filter_gen->get_rate()){
+    call_warning("in roj_filter_bank :: filter_lanes");    
+    call_error("rates are not equal");
+  }
+
+  roj_filter_lanes lanes(&m_filter_array[a_first], a_count);
+  lanes.process(a_sig, a_outputs, a_hop, a_stride);
+}
+
+/**
+ * @type: method
+ * @brief: This routine filters the whole signal by consecutive channels of the decimator (see set_decimation). Only output samples retained by the hop are calculated.
+ *
+ * @param [in] a_first: An index of the first channel.
+ * @param [in] a_count: A number of channels.
+ * @param [in] a_sig: An signal for filtering.
+ * @param [out] a_outputs: An array of output signals (one for each channel), which are created by this routine.
+ * @param [in] a_hop (default 1): A hopsize.
+ */
+void roj_filter_bank :: decimate (int a_first, int a_count, roj_complex_signal* a_sig, roj_complex_signal** a_outputs, int a_hop){
+
+  if(m_decimator==NULL){
+    call_warning("in roj_filter_bank :: decimate");
+    call_error("decimating mode is not set");
+  }
+
+  if(a_sig == NULL){
+    call_warning("in roj_filter_bank :: decimate");
+    call_error("sig is NULL");
+  }
+
+  if(a_sig->get_config().rate != m_filter_gen->get_rate()){
+    call_warning("in roj_filter_bank :: decimate");    
+    call_error("rates are not equal");
+  }
+
+  m_decimator->process(a_first, a_count, a_sig, a_outputs, a_hop);
+}
+
+/**
+ * @type: method
+ * @brief: This routine filters the whole signal by consecutive channels of the decimator and stores retained output samples into given buffers (see filter_lanes).
+ *
+ * @param [in] a_first: An index of the first channel.
+ * @param [in] a_count: A number of channels.
+ * @param [in] a_sig: An signal for filtering.
+ * @param [out] a_outputs: Pointers to the first output sample of each channel.
+ * @param [in] a_hop (default 1): A hopsize.
+ * @param [in] a_stride (default 1): A distance between consecutive output samples of a channel.
+ */
+void roj_filter_bank :: decimate (int a_first, int a_count, roj_complex_signal* a_sig, roj_complex** a_outputs, int a_hop, int a_stride){
+
+  if(m_decimator==NULL){
+    call_warning("in roj_filter_bank :: decimate");
+    call_error("decimating mode is not set");
+  }
+
+  if(a_sig == NULL){
+    call_warning("in roj_filter_bank :: decimate");
+    call_error("sig is NULL");
+  }
+
+  roj_signal_config in_conf = a_sig->get_config();
+  if(in_conf.rate != m_filter_gen->get_rate()){
+    call_warning("in roj_filter_bank :: decimate");    
+    call_error("rates are not equal");
+  }
+
+  /* the decimator of a bank has one tap */
+  roj_complex** taps[1] = {a_outputs};
+  m_decimator->process(a_first, a_count, a_sig->m_waveform, in_conf.length, taps, a_hop, 0, a_stride);
+}
@@ -31,6 +31,15 @@ class roj_filter;
 #include "roj-filter-gener.hh"
 class roj_filter_generator;
 
+#include "roj-filter-job.hh"
+class roj_filter_job;
+
+#include "roj-filter-lanes.hh"
+class roj_filter_lanes;
+
+#include "roj-ode-decim.hh"
+class roj_ode_decimator;
+
 /* ************************************************************************************************************************* */
 /* filter bank class definition */
 
@@ -41,6 +50,13 @@ private:
   roj_filter_generator* m_filter_gen;
   roj_array_config m_config;
 
+  /* number of worker threads */
+  unsigned int m_threads;
+
+  /* decimating mode */
+  bool m_decimation;
+  roj_ode_decimator* m_decimator;
+
 public:
 
   /* creation */
@@ -50,9 +66,17 @@ public:
   /* configuration */
   roj_array_config get_config();
   double get_frequency(int =0);
+  void set_threads(unsigned int =1);
+  void set_decimation(bool =true);
+  bool get_decimation();
   
   /* processing */
   roj_complex_signal** filtering(roj_complex_signal*, int =1);
+  roj_complex_signal* filter_channel(int, roj_complex_signal*, int =1);
+  void filter_lanes(int, int, roj_complex_signal*, roj_complex_signal**, int =1);
+  void filter_lanes(int, int, roj_complex_signal*, roj_complex**, int =1, int =1);
+  void decimate(int, int, roj_complex_signal*, roj_complex_signal**, int =1);
+  void decimate(int, int, roj_complex_signal*, roj_complex**, int =1, int =1);
   void filtering(complex double);
 
   /* components */
@@ -221,3 +221,48 @@ roj_filter* roj_filter_generator :: get_ode_filter(){
   return filter;
 }
 
+
+/**
+* @type: method
+* @brief: This method generates a decimating form of a bank of ODE filters (see roj_ode_decimator). Numerator coefficients of the ODE filter are proportional to powers of alpha, so partial fraction weights of sections are real and do not depend on frequency. Taps are filters of orders from order-taps+1 to order, they share the same pole.
+*
+* @param [in] a_bank_conf: A bank configuration (frequencies of channels).
+* @param [in] a_taps (default 1): A number of taps.
+*
+* @return: A pointer to generated decimator.
+*/
+roj_ode_decimator* roj_filter_generator :: get_ode_decimator(roj_array_config a_bank_conf, unsigned int a_taps){
+
+  roj_ode_decimator* decimator = new roj_ode_decimator(m_order, a_bank_conf.length, a_taps);
+
+  double delta = (a_bank_conf.max - a_bank_conf.min) / (a_bank_conf.length-1);
+  if (a_bank_conf.length == 1)
+    delta = 0.0;
+
+  for(int n=0; n<a_bank_conf.length; n++){
+
+    double frequency = a_bank_conf.min + n * delta;
+    complex double pole = I*TWO_PI * frequency -1.0/m_spread;
+    complex double alpha = cexp(pole / m_rate);
+    decimator->m_alpha_re[n] = creal(alpha);
+    decimator->m_alpha_im[n] = cimag(alpha);
+  }
+
+  double n_spread = m_spread * m_rate;
+  for(int t=0; t<a_taps; t++){
+
+    int order = m_order - a_taps + 1 + t;
+    double b_factor = 1.0 / (pow(n_spread, order) * calc_factorial(order));
+
+    /* weight of k-th section is coefficient of (1-alpha/z)^(order-k) in B(z) */
+    for(int k=1; k<=order; k++){
+      int j = order - k;
+      double weight = 0.0;
+      for(int i=j; i<order; i++)
+	weight += calc_eulerian(order, order-i) * calc_binominal(i, j);
+      decimator->m_weights[t][k-1] = b_factor * pow(-1.0, j) * weight;
+    }
+  }
+
+  return decimator;
+}
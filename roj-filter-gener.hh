@@ -24,6 +24,9 @@
 #include "roj-filter.hh"
 class roj_filter;
 
+#include "roj-ode-decim.hh"
+class roj_ode_decimator;
+
 #include "roj-complex-signal.hh"
 struct roj_signal_config;
 class roj_complex_signal;
@@ -67,6 +70,7 @@ public:
   /* generate methods */
   /* ******************************** */
   roj_filter* get_ode_filter ();  
+  roj_ode_decimator* get_ode_decimator (roj_array_config, unsigned int =1);
   roj_filter* get_filter ();
 };
 
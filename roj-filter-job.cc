@@ -0,0 +1,263 @@
+/* *************************************************** *
+ * This file is a part of ccROJ project (version 0-49) *
+ * distributed under GNU General Public License v3.0.  *
+ * Please visit the webpage: github.com/dsp-box/ccROJ  *
+ * for more information.                               *
+ *                       contact: Krzysztof Czarnecki  *
+ *                email: czarnecki.krzysiek@gmail.com  *
+ * *************************************************** */
+
+#include "roj-filter-job.hh"
+#include "roj-filter-bank.hh"
+#include "roj-ode-decim.hh"
+
+/* ************************************************************************************************************************* */
+/**
+* @type: constructor
+* @brief: This is a constructor of roj_filter_job.
+*
+* @param [in] a_sig: A signal for filtering.
+* @param [in] a_hop (default 1): A hopsize.
+*/
+roj_filter_job :: roj_filter_job (roj_complex_signal* a_sig, int a_hop){
+
+  if(a_sig == NULL){
+    call_warning("in roj_filter_job :: roj_filter_job");
+    call_error("sig is NULL");
+  }
+
+  if(a_hop<1){
+    call_warning("in roj_filter_job :: roj_filter_job");
+    call_error("hop<1");
+  }
+
+  m_input = a_sig;
+  m_hop = a_hop;
+  m_channels = 0;
+  m_blocks = 0;
+  m_decimator = NULL;
+  m_taps = NULL;
+  m_tap_images = NULL;
+}
+
+/**
+* @type: destructor
+* @brief: This is a destructor of roj_filter_job. Output signals are not released.
+*/
+roj_filter_job :: ~roj_filter_job (){
+}
+
+/* ************************************************************************************************************************* */
+/**
+* @type: private
+* @brief: This routine checks that all banks (and the decimator) of a job have the same number of channels.
+*
+* @param [in] a_channels: A number of channels of an added bank.
+* @param [in] a_name: A name of the calling method.
+*/
+void roj_filter_job :: check_channels (int a_channels, const char* a_name){
+
+  if((m_banks.size()>0 or m_decimator!=NULL) and a_channels!=m_channels){
+    call_warning(a_name);
+    call_error("banks have different number of channels");
+  }
+
+  m_channels = a_channels;
+  m_blocks = (a_channels + ROJ_FILTER_LANES - 1) / ROJ_FILTER_LANES;
+}
+
+/**
+* @type: private
+* @brief: This routine returns a distance between rows of a time-major matrix allocated by allocate_complex_rows.
+*
+* @param [in] a_image: Rows of the matrix (one for each retained sample).
+*
+* @return: The row stride (in samples).
+*/
+int roj_filter_job :: get_stride (roj_complex** a_image){
+
+  if(m_input->get_config().length / m_hop < 2)
+    return 1;
+  return a_image[1] - a_image[0];
+}
+
+/**
+* @type: method
+* @brief: This routine adds a bank to the job. All banks (and the decimator) of a job have to have the same number of channels.
+*
+* @param [in] a_bank: A pointer to a filter bank.
+* @param [out] a_outputs: An array of output signals (one for each channel). Output signals are created by the job.
+*/
+void roj_filter_job :: add_bank (roj_filter_bank* a_bank, roj_complex_signal** a_outputs){
+
+  if(a_bank==NULL or a_outputs==NULL){
+    call_warning("in roj_filter_job :: add_bank");
+    call_error("arg is null");
+  }
+
+  check_channels(a_bank->get_config().length, "in roj_filter_job :: add_bank");
+  m_banks.push_back(a_bank);
+  m_outputs.push_back(a_outputs);
+  m_images.push_back(NULL);
+}
+
+/**
+* @type: method
+* @brief: This routine adds a bank, whose outputs are stored in a time-major matrix. Each block of channels is stored side by side in rows, so no transposition is needed.
+*
+* @param [in] a_bank: A pointer to a filter bank.
+* @param [out] a_image: Rows allocated by allocate_complex_rows (signal length divided by hop rows of bank length samples).
+*/
+void roj_filter_job :: add_bank (roj_filter_bank* a_bank, roj_complex** a_image){
+
+  if(a_bank==NULL or a_image==NULL){
+    call_warning("in roj_filter_job :: add_bank");
+    call_error("arg is null");
+  }
+
+  check_channels(a_bank->get_config().length, "in roj_filter_job :: add_bank");
+  m_banks.push_back(a_bank);
+  m_outputs.push_back(NULL);
+  m_images.push_back(a_image);
+}
+
+/**
+* @type: method
+* @brief: This routine adds a decimator to the job. All taps of the decimator are obtained by one recursion. The job can contain only one decimator.
+*
+* @param [in] a_decimator: A pointer to a decimator.
+* @param [out] a_outputs: Arrays of output signals for each tap (one for each channel, NULL if a tap is not requested). Output signals are created by the job.
+*/
+void roj_filter_job :: add_decimator (roj_ode_decimator* a_decimator, roj_complex_signal*** a_outputs){
+
+  if(a_decimator==NULL or a_outputs==NULL){
+    call_warning("in roj_filter_job :: add_decimator");
+    call_error("arg is null");
+  }
+
+  if(m_decimator!=NULL){
+    call_warning("in roj_filter_job :: add_decimator");
+    call_error("decimator is already added");
+  }
+
+  check_channels(a_decimator->get_count(), "in roj_filter_job :: add_decimator");
+  m_decimator = a_decimator;
+  m_taps = a_outputs;
+}
+
+/**
+* @type: method
+* @brief: This routine adds a decimator, whose taps are stored in time-major matrices (see add_bank). The job can contain only one decimator.
+*
+* @param [in] a_decimator: A pointer to a decimator.
+* @param [out] a_images: Rows allocated by allocate_complex_rows for each tap (NULL if a tap is not requested).
+*/
+void roj_filter_job :: add_decimator (roj_ode_decimator* a_decimator, roj_complex*** a_images){
+
+  if(a_decimator==NULL or a_images==NULL){
+    call_warning("in roj_filter_job :: add_decimator");
+    call_error("arg is null");
+  }
+
+  if(m_decimator!=NULL){
+    call_warning("in roj_filter_job :: add_decimator");
+    call_error("decimator is already added");
+  }
+
+  check_channels(a_decimator->get_count(), "in roj_filter_job :: add_decimator");
+  m_decimator = a_decimator;
+  m_tap_images = a_images;
+}
+
+/**
+* @type: method
+* @brief: This routine filters the signal by all channels of added banks and the decimator.
+*
+* @param [in] a_threads (default 1): A number of worker threads.
+*/
+void roj_filter_job :: run (unsigned int a_threads){
+
+  int items = m_banks.size() * m_blocks;
+  if(m_decimator!=NULL)
+    items += m_blocks;
+  if(items<1)
+    return;
+
+  roj_parallel_job :: run(items, a_threads);
+  print_progress(0, 0, "filtering");
+}
+
+/**
+* @type: private
+* @brief: This routine filters the signal by one block of channels. Banks in the decimating mode use their decimators, if hop>1. Items which follow blocks of banks are blocks of the decimator.
+*
+* @param [in] a_item: An index of the item (bank index times number of blocks plus block index).
+* @param [in] a_worker: An index of the worker.
+*/
+void roj_filter_job :: execute (int a_item, int a_worker){
+
+  int b = a_item / m_blocks;
+  int first = (a_item % m_blocks) * ROJ_FILTER_LANES;
+
+  int count = m_channels - first;
+  if(count > ROJ_FILTER_LANES)
+    count = ROJ_FILTER_LANES;
+
+  if(b == m_banks.size() and m_tap_images!=NULL){
+
+    /* block of decimator taps stored side by side in rows */
+    int taps = m_decimator->get_taps();
+    roj_complex*** outputs = new roj_complex** [taps];
+    int stride = 1;
+
+    for(int t=0; t<taps; t++){
+      outputs[t] = NULL;
+      if(m_tap_images[t]!=NULL){
+	outputs[t] = new roj_complex* [count];
+	for(int c=0; c<count; c++)
+	  outputs[t][c] = &m_tap_images[t][0][first+c];
+	stride = get_stride(m_tap_images[t]);
+      }
+    }
+
+    m_decimator->process(first, count, m_input->m_waveform, m_input->get_config().length, outputs, m_hop, 0, stride);
+
+    for(int t=0; t<taps; t++)
+      delete [] outputs[t];
+    delete [] outputs;
+  }
+  else if(b == m_banks.size()){
+
+    /* block of decimator taps */
+    int taps = m_decimator->get_taps();
+    roj_complex_signal*** outputs = new roj_complex_signal** [taps];
+    for(int t=0; t<taps; t++)
+      outputs[t] = m_taps[t]!=NULL ? &m_taps[t][first] : NULL;
+
+    m_decimator->process(first, count, m_input, outputs, m_hop);
+    delete [] outputs;
+  }
+  else if(m_images[b]!=NULL){
+
+    /* channels of the block are side by side in rows */
+    roj_complex** outputs = new roj_complex* [count];
+    for(int c=0; c<count; c++)
+      outputs[c] = &m_images[b][0][first+c];
+    int stride = get_stride(m_images[b]);
+
+    if(m_banks[b]->get_decimation() and m_hop>1)
+      m_banks[b]->decimate(first, count, m_input, outputs, m_hop, stride);
+    else
+      m_banks[b]->filter_lanes(first, count, m_input, outputs, m_hop, stride);
+    delete [] outputs;
+  }
+  else if(m_banks[b]->get_decimation() and m_hop>1)
+    m_banks[b]->decimate(first, count, m_input, &m_outputs[b][first], m_hop);
+  else
+    m_banks[b]->filter_lanes(first, count, m_input, &m_outputs[b][first], m_hop);
+
+  int total = m_banks.size() * m_channels;
+  if(m_decimator!=NULL)
+    total += m_channels;
+  print_progress(finish_items(count), total, "filtering");
+}
@@ -0,0 +1,72 @@
+/* *************************************************** *
+ * This file is a part of ccROJ project (version 0-49) *
+ * distributed under GNU General Public License v3.0.  *
+ * Please visit the webpage: github.com/dsp-box/ccROJ  *
+ * for more information.                               *
+ *                       contact: Krzysztof Czarnecki  *
+ *                email: czarnecki.krzysiek@gmail.com  *
+ * *************************************************** */
+
+#ifndef _roj_filter_job_
+#define _roj_filter_job_
+
+/**
+* @type: class
+* @brief: Definition of roj_filter_job class. It filters a signal by channels of many filter banks. An item of the job is a block of ROJ_FILTER_LANES channels of one bank, which are filtered together by the vectorized engine, so blocks of all banks are distributed between worker threads. A job can also contain one decimator (see roj_ode_decimator), whose blocks give outputs of many taps. Filters of different channels have separate states. Each channel has its own output signal, or outputs of a bank are stored in one time-major matrix (a row for each retained sample), so all channels of a time instant are side by side.
+* @herit: roj_filter_job : roj_parallel_job
+*/
+
+/* ************************************************************************************************************************* */
+/* headers and declarations */
+
+#include "roj-parallel.hh"
+class roj_parallel_job;
+
+#include "roj-complex-signal.hh"
+class roj_complex_signal;
+
+class roj_filter_bank;
+class roj_ode_decimator;
+
+/* ************************************************************************************************************************* */
+/* filter job class definition */
+
+class roj_filter_job
+  : public roj_parallel_job{
+
+private:
+
+  /* banks and their outputs (signals or time-major matrices) */
+  std::vector<roj_filter_bank*> m_banks;
+  std::vector<roj_complex_signal**> m_outputs;
+  std::vector<roj_complex**> m_images;
+  int m_channels;
+  int m_blocks;
+
+  /* shared-pole cascade and outputs of its taps */
+  roj_ode_decimator* m_decimator;
+  roj_complex_signal*** m_taps;
+  roj_complex*** m_tap_images;
+
+  /* input signal */
+  roj_complex_signal* m_input;
+  int m_hop;
+
+  void execute(int, int);
+  void check_channels(int, const char*);
+  int get_stride(roj_complex**);
+  
+public:
+
+  /* construction */
+  roj_filter_job(roj_complex_signal*, int =1);
+  ~roj_filter_job();
+
+  void add_bank(roj_filter_bank*, roj_complex_signal**);
+  void add_bank(roj_filter_bank*, roj_complex**);
+  void add_decimator(roj_ode_decimator*, roj_complex_signal***);
+  void add_decimator(roj_ode_decimator*, roj_complex***);
+  void run(unsigned int =1);
+};
+
+#endif
@@ -0,0 +1,366 @@
+/* *************************************************** *
+ * This file is a part of ccROJ project (version 0-49) *
+ * distributed under GNU General Public License v3.0.  *
+ * Please visit the webpage: github.com/dsp-box/ccROJ  *
+ * for more information.                               *
+ *                       contact: Krzysztof Czarnecki  *
+ *                email: czarnecki.krzysiek@gmail.com  *
+ * *************************************************** */
+
+#include "roj-filter-lanes.hh"
+
+/* ************************************************************************************************************************* */
+/* static fields */
+
+const char* roj_filter_lanes :: m_isa = NULL;
+
+/* ************************************************************************************************************************* */
+/**
+* @type: function
+* @brief: This routine filters a signal by all lanes. Operations of roj_filter :: process are repeated in the same order for split real and imaginary parts, and the loops over lanes are vectorized.
+*
+* @param [in] a_lanes: A number of lanes (a multiple of vector length).
+* @param [in] a_count: A number of used lanes (filters).
+* @param [in] a_order: A filter order.
+* @param [in] a_outlen: A length of output delay ring.
+* @param [in, out] a_index: A position in the output delay ring.
+* @param [in, out] a_rows: Coefficients and states of lanes.
+* @param [in] a_sig: An input signal.
+* @param [out] a_outputs: Output waveforms (one for each used lane).
+* @param [in] a_hop: A hopsize.
+* @param [in] a_stride: A distance between consecutive output samples of a waveform.
+*/
+ROJ_KERNEL_INLINE void process_lanes (int a_lanes, int a_count, int a_order, int a_outlen, unsigned int* a_index,
+				      roj_lane_rows a_rows, roj_complex_signal* a_sig, roj_complex** a_outputs, int a_hop, int a_stride){
+
+  int length = a_sig->get_config().length;
+  unsigned int index = *a_index;
+
+  for(int n=0; n<length; n++){
+
+    double xr = creal(a_sig->m_waveform[n]);
+    double xi = cimag(a_sig->m_waveform[n]);
+
+    index++;
+    index %= a_outlen;
+
+    /* output: y = b0 x + s0 */
+    double* __restrict__ yr = a_rows.y_re[index];
+    double* __restrict__ yi = a_rows.y_im[index];
+    {
+      const double* __restrict__ br = a_rows.b_re[0];
+      const double* __restrict__ bi = a_rows.b_im[0];
+      const double* __restrict__ sr = a_rows.s_re[0];
+      const double* __restrict__ si = a_rows.s_im[0];
+      
+      for(int c=0; c<a_lanes; c++){
+	yr[c] = (br[c]*xr - bi[c]*xi) + sr[c];
+	yi[c] = (br[c]*xi + bi[c]*xr) + si[c];
+      }
+    }
+
+    /* states: s(i) = s(i+1) + b(i+1) x - a(i+1) y */
+    for(int i=0; i<a_order-1; i++){
+      double* __restrict__ sr = a_rows.s_re[i];
+      double* __restrict__ si = a_rows.s_im[i];
+      const double* __restrict__ nr = a_rows.s_re[i+1];
+      const double* __restrict__ ni = a_rows.s_im[i+1];
+      const double* __restrict__ br = a_rows.b_re[i+1];
+      const double* __restrict__ bi = a_rows.b_im[i+1];
+      const double* __restrict__ ar = a_rows.a_re[i+1];
+      const double* __restrict__ ai = a_rows.a_im[i+1];
+
+      for(int c=0; c<a_lanes; c++){
+	sr[c] = (nr[c] + (br[c]*xr - bi[c]*xi)) - (ar[c]*yr[c] - ai[c]*yi[c]);
+	si[c] = (ni[c] + (br[c]*xi + bi[c]*xr)) - (ar[c]*yi[c] + ai[c]*yr[c]);
+      }
+    }
+
+    {
+      double* __restrict__ sr = a_rows.s_re[a_order-1];
+      double* __restrict__ si = a_rows.s_im[a_order-1];
+      const double* __restrict__ ar = a_rows.a_re[a_order];
+      const double* __restrict__ ai = a_rows.a_im[a_order];
+
+      for(int c=0; c<a_lanes; c++){
+	sr[c] = (-ar[c])*yr[c] - (-ai[c])*yi[c];
+	si[c] = (-ar[c])*yi[c] + (-ai[c])*yr[c];
+      }
+    }
+
+    /* delayed output (see roj_filter :: get_output) */
+    if(n%a_hop == a_hop-1){
+      unsigned int delayed = (index+1) % a_outlen;
+      for(int c=0; c<a_count; c++){
+	roj_complex* sample = &a_outputs[c][(size_t)(n/a_hop) * a_stride];
+	__real__ *sample = a_rows.y_re[delayed][c];
+	__imag__ *sample = a_rows.y_im[delayed][c];
+      }
+    }
+  }
+
+  *a_index = index;
+}
+
+/* instruction set variants */
+
+#ifdef ROJ_KERNEL_DISPATCH
+__attribute__((target("avx512f,avx512dq"), optimize("tree-vectorize")))
+static void process_lanes_avx512 (int a_lanes, int a_count, int a_order, int a_outlen, unsigned int* a_index,
+				  roj_lane_rows a_rows, roj_complex_signal* a_sig, roj_complex** a_outputs, int a_hop, int a_stride){
+
+  process_lanes(a_lanes, a_count, a_order, a_outlen, a_index, a_rows, a_sig, a_outputs, a_hop, a_stride);
+}
+
+__attribute__((target("avx2,fma"), optimize("tree-vectorize")))
+static void process_lanes_avx2 (int a_lanes, int a_count, int a_order, int a_outlen, unsigned int* a_index,
+				roj_lane_rows a_rows, roj_complex_signal* a_sig, roj_complex** a_outputs, int a_hop, int a_stride){
+
+  process_lanes(a_lanes, a_count, a_order, a_outlen, a_index, a_rows, a_sig, a_outputs, a_hop, a_stride);
+}
+#endif
+
+__attribute__((optimize("tree-vectorize")))
+static void process_lanes_generic (int a_lanes, int a_count, int a_order, int a_outlen, unsigned int* a_index,
+				   roj_lane_rows a_rows, roj_complex_signal* a_sig, roj_complex** a_outputs, int a_hop, int a_stride){
+
+  process_lanes(a_lanes, a_count, a_order, a_outlen, a_index, a_rows, a_sig, a_outputs, a_hop, a_stride);
+}
+
+/* ************************************************************************************************************************* */
+/**
+* @type: constructor
+* @brief: This is a constructor of roj_filter_lanes. Coefficients and states of filters are copied into lanes.
+*
+* @param [in] a_filters: An array of filters (all of them have the same order and delay).
+* @param [in] a_count: A number of filters.
+*/
+roj_filter_lanes :: roj_filter_lanes (roj_filter** a_filters, int a_count){
+
+  if(a_filters==NULL){
+    call_warning("in roj_filter_lanes :: roj_filter_lanes");
+    call_error("arg is null");
+  }
+
+  if(a_count<1){
+    call_warning("in roj_filter_lanes :: roj_filter_lanes");
+    call_error("number of filters < 1");
+  }
+
+  m_filters = a_filters;
+  m_count = a_count;
+  m_order = m_filters[0]->m_order;
+  m_outlen = m_filters[0]->m_outlen;
+  m_index = m_filters[0]->m_index;
+
+  for(int c=1; c<m_count; c++)
+    if(m_filters[c]->m_order!=m_order or m_filters[c]->m_outlen!=m_outlen or m_filters[c]->m_index!=m_index){
+      call_warning("in roj_filter_lanes :: roj_filter_lanes");
+      call_error("filters have different orders or states");
+    }
+
+  /* lanes are padded to the alignment */
+  int unit = ROJ_ALIGNMENT / sizeof(double);
+  m_lanes = (m_count + unit - 1) / unit * unit;
+
+  /* a: order+1 rows, b and s: order rows, y: outlen rows */
+  int rows = 2 * (3*m_order + 1 + m_outlen);
+  size_t byte_size = (size_t)rows * m_lanes * sizeof(double);
+  if(posix_memalign(&m_memory, ROJ_ALIGNMENT, byte_size) != 0)
+    call_error("memory cannot be allocated");
+  memset(m_memory, 0x0, byte_size);
+
+  double** row_ptrs = new double*[rows];
+  for(int r=0; r<rows; r++)
+    row_ptrs[r] = (double*)m_memory + (size_t)r * m_lanes;
+
+  m_rows.a_re = row_ptrs;
+  m_rows.a_im = m_rows.a_re + m_order + 1;
+  m_rows.b_re = m_rows.a_im + m_order + 1;
+  m_rows.b_im = m_rows.b_re + m_order;
+  m_rows.s_re = m_rows.b_im + m_order;
+  m_rows.s_im = m_rows.s_re + m_order;
+  m_rows.y_re = m_rows.s_im + m_order;
+  m_rows.y_im = m_rows.y_re + m_outlen;
+
+  load();
+}
+
+/**
+* @type: destructor
+* @brief: This is a destructor of roj_filter_lanes.
+*/
+roj_filter_lanes :: ~roj_filter_lanes (){
+
+  delete [] m_rows.a_re;
+  free(m_memory);
+}
+
+/* ************************************************************************************************************************* */
+/**
+* @type: private
+* @brief: This routine copies coefficients and states of filters into lanes.
+*/
+void roj_filter_lanes :: load (){
+
+  for(int c=0; c<m_count; c++){
+    roj_filter* filter = m_filters[c];
+
+    for(int i=0; i<=m_order; i++){
+      m_rows.a_re[i][c] = creal(filter->m_acoeff[i]);
+      m_rows.a_im[i][c] = cimag(filter->m_acoeff[i]);
+    }
+
+    for(int i=0; i<m_order; i++){
+      m_rows.b_re[i][c] = creal(filter->m_bcoeff[i]);
+      m_rows.b_im[i][c] = cimag(filter->m_bcoeff[i]);
+      m_rows.s_re[i][c] = creal(filter->m_buffer[i]);
+      m_rows.s_im[i][c] = cimag(filter->m_buffer[i]);
+    }
+
+    for(int j=0; j<m_outlen; j++){
+      m_rows.y_re[j][c] = creal(filter->m_output[j]);
+      m_rows.y_im[j][c] = cimag(filter->m_output[j]);
+    }
+  }
+}
+
+/**
+* @type: private
+* @brief: This routine copies states of lanes back to filters, so filters can be used further by roj_filter :: process.
+*/
+void roj_filter_lanes :: store (){
+
+  for(int c=0; c<m_count; c++){
+    roj_filter* filter = m_filters[c];
+
+    for(int i=0; i<m_order; i++){
+      __real__ filter->m_buffer[i] = m_rows.s_re[i][c];
+      __imag__ filter->m_buffer[i] = m_rows.s_im[i][c];
+    }
+
+    for(int j=0; j<m_outlen; j++){
+      __real__ filter->m_output[j] = m_rows.y_re[j][c];
+      __imag__ filter->m_output[j] = m_rows.y_im[j][c];
+    }
+
+    filter->m_index = m_index;
+  }
+}
+
+/* ************************************************************************************************************************* */
+/**
+* @type: method
+* @brief: This routine filters the whole signal by all filters. Each hop-th delayed output sample is stored (as in roj_filter_bank :: filter_channel).
+*
+* @param [in] a_sig: An input signal.
+* @param [out] a_outputs: Allocated output signals (one for each filter), their length is at least the signal length divided by hop.
+* @param [in] a_hop (default 1): A hopsize.
+*/
+void roj_filter_lanes :: process (roj_complex_signal* a_sig, roj_complex_signal** a_outputs, int a_hop){
+
+  if(a_outputs==NULL){
+    call_warning("in roj_filter_lanes :: process");
+    call_error("arg is null");
+  }
+
+  roj_complex** waveforms = new roj_complex* [m_count];
+  for(int c=0; c<m_count; c++)
+    waveforms[c] = a_outputs[c]->m_waveform;
+
+  process(a_sig, waveforms, a_hop);
+  delete [] waveforms;
+}
+
+/**
+* @type: method
+* @brief: This routine filters the whole signal by all filters and stores each hop-th delayed output sample into given buffers. A stride equal to a row length of a time-major matrix (see allocate_complex_rows) stores outputs of all filters of a time instant side by side.
+*
+* @param [in] a_sig: An input signal.
+* @param [out] a_outputs: Pointers to the first output sample of each filter.
+* @param [in] a_hop (default 1): A hopsize.
+* @param [in] a_stride (default 1): A distance between consecutive output samples of a filter.
+*/
+void roj_filter_lanes :: process (roj_complex_signal* a_sig, roj_complex** a_outputs, int a_hop, int a_stride){
+
+  if(a_sig==NULL or a_outputs==NULL){
+    call_warning("in roj_filter_lanes :: process");
+    call_error("arg is null");
+  }
+
+  if(a_hop<1){
+    call_warning("in roj_filter_lanes :: process");
+    call_error("hop<1");
+  }
+
+#ifdef ROJ_KERNEL_DISPATCH
+  const char* isa = get_isa();
+  if(strcmp(isa, "avx512")==0)
+    process_lanes_avx512(m_lanes, m_count, m_order, m_outlen, &m_index, m_rows, a_sig, a_outputs, a_hop, a_stride);
+  else if(strcmp(isa, "avx2")==0)
+    process_lanes_avx2(m_lanes, m_count, m_order, m_outlen, &m_index, m_rows, a_sig, a_outputs, a_hop, a_stride);
+  else
+#endif
+    process_lanes_generic(m_lanes, m_count, m_order, m_outlen, &m_index, m_rows, a_sig, a_outputs, a_hop, a_stride);
+
+  store();
+}
+
+/**
+* @type: method
+* @brief: This function returns a name of the instruction set used by the engine (and by roj_ode_decimator).
+*
+* @return: "avx512", "avx2" or "generic".
+*/
+const char* roj_filter_lanes :: get_isa (){
+
+  if(m_isa!=NULL)
+    return m_isa;
+
+#ifdef ROJ_KERNEL_DISPATCH
+  if(__builtin_cpu_supports("avx512f") and __builtin_cpu_supports("avx512dq"))
+    return "avx512";
+  if(__builtin_cpu_supports("avx2") and __builtin_cpu_supports("fma"))
+    return "avx2";
+#endif
+  return "generic";
+}
+
+/**
+* @type: method
+* @brief: This function forces an instruction set of the engine (and of roj_ode_decimator), e.g. to compare results of all variants. It should not be called while signals are filtered.
+*
+* @param [in] a_isa (default NULL): "avx512", "avx2", "generic" or NULL for the best available set.
+*
+* @return: False if the instruction set is not supported by the processor (the selection is not changed).
+*/
+bool roj_filter_lanes :: set_isa (const char* a_isa){
+
+  if(a_isa==NULL){
+    m_isa = NULL;
+    return true;
+  }
+
+  if(strcmp(a_isa, "generic")==0){
+    m_isa = "generic";
+    return true;
+  }
+
+  if(strcmp(a_isa, "avx512")!=0 and strcmp(a_isa, "avx2")!=0){
+    call_warning("in roj_filter_lanes :: set_isa");
+    call_error("unknown instruction set");
+  }
+
+#ifdef ROJ_KERNEL_DISPATCH
+  if(strcmp(a_isa, "avx512")==0 and __builtin_cpu_supports("avx512f") and __builtin_cpu_supports("avx512dq")){
+    m_isa = "avx512";
+    return true;
+  }
+
+  if(strcmp(a_isa, "avx2")==0 and __builtin_cpu_supports("avx2") and __builtin_cpu_supports("fma")){
+    m_isa = "avx2";
+    return true;
+  }
+#endif
+  return false;
+}
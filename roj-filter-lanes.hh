@@ -0,0 +1,88 @@
+/* *************************************************** *
+ * This file is a part of ccROJ project (version 0-49) *
+ * distributed under GNU General Public License v3.0.  *
+ * Please visit the webpage: github.com/dsp-box/ccROJ  *
+ * for more information.                               *
+ *                       contact: Krzysztof Czarnecki  *
+ *                email: czarnecki.krzysiek@gmail.com  *
+ * *************************************************** */
+
+#ifndef _roj_filter_lanes_
+#define _roj_filter_lanes_
+
+/**
+* @type: class
+* @brief: Definition of roj_filter_lanes class. It is a vectorized engine, which advances many filters of the same order in lockstep. Coefficients and states of filters are stored as structure of arrays (split real and imaginary parts, one element for each filter), so each filter is a lane of SIMD registers. AVX-512 and AVX2 versions are selected at runtime, unless an instruction set is forced by set_isa. States are loaded from and stored to roj_filter objects, so the result is the same as of roj_filter :: process.
+*/
+
+/* ************************************************************************************************************************* */
+/* headers and declarations */
+
+#include "roj-external.hh"
+#include "roj-misc.hh"
+
+#include "roj-filter.hh"
+class roj_filter;
+
+#include "roj-complex-signal.hh"
+class roj_complex_signal;
+
+/* ************************************************************************************************************************* */
+/* structure definitions */
+
+/**
+* @type: struct
+* @brief: This structure contains rows of lanes: a - denominator and b - numerator coefficients, s - transposed direct form states, y - output delay ring. Each row is split into real (re) and imaginary (im) parts.
+*/
+struct roj_lane_rows{
+
+  double** a_re;
+  double** a_im;
+  double** b_re;
+  double** b_im;
+  double** s_re;
+  double** s_im;
+  double** y_re;
+  double** y_im;
+};
+
+/* ************************************************************************************************************************* */
+/* lanes class definition */
+
+class roj_filter_lanes{
+private:
+
+  /* filters */
+  roj_filter** m_filters;
+  int m_count;
+  int m_lanes;
+
+  /* configuration (common for all filters) */
+  unsigned int m_order;
+  unsigned int m_outlen;
+  unsigned int m_index;
+
+  /* aligned rows */
+  void* m_memory;
+  roj_lane_rows m_rows;
+
+  /* selected instruction set (NULL for the best available) */
+  static const char* m_isa;
+
+  void load();
+  void store();
+  
+public:
+
+  /* construction */
+  roj_filter_lanes(roj_filter**, int);
+  ~roj_filter_lanes();
+
+  /* processing */
+  void process(roj_complex_signal*, roj_complex_signal**, int =1);
+  void process(roj_complex_signal*, roj_complex**, int =1, int =1);
+  static const char* get_isa();
+  static bool set_isa(const char* =NULL);
+};
+
+#endif
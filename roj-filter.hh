@@ -32,6 +32,7 @@ class roj_filter_generator;
 
 class roj_filter{
   friend class roj_filter_generator;
+  friend class roj_filter_lanes;
   
 private:
 
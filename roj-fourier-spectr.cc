@@ -12,7 +12,7 @@
 /* ************************************************************************************************************************* */
 /**
 * @type: constructor
-* @brief: This is a constructor of roj_fourier_spectrum based on signal object using the rectangular window. 
+* @brief: This is a constructor of roj_fourier_spectrum based on signal object using the rectangular window. A real signal is transformed by r2c FFT.
 *
 * @param [in] a_signal: A pointer to a signal which is transformed.
 */
@@ -20,16 +20,27 @@ roj_fourier_spectrum :: roj_fourier_spectrum (roj_complex_signal* a_signal){
   
   m_config = a_signal->get_config();
 
-  m_spectrum = fftw_alloc_complex(m_config.length);
-  int byte_size = m_config.length * sizeof(complex double);
+  m_spectrum = roj_fftw(alloc_complex)(m_config.length);
+  int byte_size = m_config.length * sizeof(roj_complex);
   memset(m_spectrum, 0x0, byte_size);
   
-  fftw_plan pl = fftw_plan_dft_1d(m_config.length, a_signal->m_waveform, m_spectrum, FFTW_FORWARD, FFTW_ESTIMATE);
+  /* real signals are transformed by r2c fft */
+  if(a_signal->check_imag())
+    roj_fft_plan_cache :: execute(m_config.length, FFTW_FORWARD, a_signal->m_waveform, m_spectrum);
+  else{
+    roj_real* real_tmp = roj_fftw(alloc_real)(m_config.length);
+    for(int n=0; n<m_config.length; n++)
+      real_tmp[n] = creal(a_signal->m_waveform[n]);
+    
+    roj_fft_plan_cache :: execute_r2c(m_config.length, real_tmp, m_spectrum);
+    roj_fftw(free)(real_tmp);
 
-  fftw_execute(pl);  
+    /* Hermitian symmetry */
+    for(int n=m_config.length/2+1; n<m_config.length; n++)
+      m_spectrum[n] = conj(m_spectrum[m_config.length-n]);
+  }
+  
   fft_shift();
-
-  fftw_destroy_plan(pl);
 }
 
 /**
@@ -38,7 +49,7 @@ roj_fourier_spectrum :: roj_fourier_spectrum (roj_complex_signal* a_signal){
 */
 roj_fourier_spectrum :: ~roj_fourier_spectrum (){
 
-  fftw_free(m_spectrum);
+  roj_fftw(free)(m_spectrum);
 }
 
 /* ************************************************************************************************************************* */
@@ -48,9 +59,9 @@ roj_fourier_spectrum :: ~roj_fourier_spectrum (){
 */
 void roj_fourier_spectrum :: fft_shift (){
 
-  complex double* tmp_buffer = new complex double[1+m_config.length/2];
-  int byte_size = (m_config.length/2) * sizeof(complex double);
-  memset(tmp_buffer, 0x0, byte_size + sizeof(complex double));
+  roj_complex* tmp_buffer = new roj_complex[1+m_config.length/2];
+  int byte_size = (m_config.length/2) * sizeof(roj_complex);
+  memset(tmp_buffer, 0x0, byte_size + sizeof(roj_complex));
   
   if(m_config.length%2==0){					
     memcpy(tmp_buffer, m_spectrum, byte_size);
@@ -58,9 +69,9 @@ void roj_fourier_spectrum :: fft_shift (){
     memcpy(&m_spectrum[m_config.length/2], tmp_buffer, byte_size);
   }
   else{
-    memcpy(tmp_buffer, m_spectrum, byte_size+sizeof(complex double));
+    memcpy(tmp_buffer, m_spectrum, byte_size+sizeof(roj_complex));
     memcpy(m_spectrum, &m_spectrum[1+m_config.length/2], byte_size);
-    memcpy(&m_spectrum[m_config.length/2], tmp_buffer, byte_size+sizeof(complex double));
+    memcpy(&m_spectrum[m_config.length/2], tmp_buffer, byte_size+sizeof(roj_complex));
   }
 
   delete [] tmp_buffer;
@@ -76,8 +87,8 @@ void roj_fourier_spectrum :: fft_shift (){
 roj_complex_signal* roj_fourier_spectrum :: get_signal (){
 
   roj_complex_signal* signal = new roj_complex_signal(m_config);
-  complex double* tmp_buffer = fftw_alloc_complex(m_config.length);
-  int byte_size = sizeof(complex double) * (m_config.length / 2);
+  roj_complex* tmp_buffer = roj_fftw(alloc_complex)(m_config.length);
+  int byte_size = sizeof(roj_complex) * (m_config.length / 2);
 
   /* inverse fftshift */
   if(m_config.length%2==0){
@@ -85,15 +96,13 @@ roj_complex_signal* roj_fourier_spectrum :: get_signal (){
     memcpy(&tmp_buffer[m_config.length/2], m_spectrum, byte_size);
   }
   else{
-    memcpy(tmp_buffer, &m_spectrum[m_config.length/2], byte_size+sizeof(complex double));
+    memcpy(tmp_buffer, &m_spectrum[m_config.length/2], byte_size+sizeof(roj_complex));
     memcpy(&tmp_buffer[m_config.length/2+1], m_spectrum, byte_size);
   }
 
   /* inverse transform */
-  fftw_plan pl = fftw_plan_dft_1d(m_config.length, tmp_buffer, signal->m_waveform, FFTW_BACKWARD, FFTW_ESTIMATE);
-  fftw_execute(pl);  
-  fftw_destroy_plan(pl);
-  fftw_free(tmp_buffer);
+  roj_fft_plan_cache :: execute(m_config.length, FFTW_BACKWARD, tmp_buffer, signal->m_waveform);
+  roj_fftw(free)(tmp_buffer);
 
   for (int n=0; n<m_config.length; n++)  
     signal->m_waveform[n] /= m_config.length;
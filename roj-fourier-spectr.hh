@@ -24,6 +24,9 @@
 #include "roj-complex-signal.hh"
 class roj_complex_signal;
 
+#include "roj-fft-plan.hh"
+class roj_fft_plan_cache;
+
 /* ************************************************************************************************************************* */
 /* fourier spectrum class definition */
 
@@ -61,7 +64,7 @@ public:
    * @type: field
    * @brief: This field gives access to spectral lines.
    */
-  complex double* m_spectrum; 
+  roj_complex* m_spectrum; 
 
 };
 
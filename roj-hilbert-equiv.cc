@@ -58,13 +58,25 @@ roj_signal_config roj_hilbert_equiv :: get_config (){
 roj_complex_signal* roj_hilbert_equiv :: get_equivalent (){
   
   if(m_equivalent==NULL){
-    roj_fourier_spectrum *spectrum = m_signal->get_spectrum(); 
-    roj_signal_config conf = spectrum->get_config();
+    roj_signal_config conf = m_signal->get_config();
+    m_equivalent = new roj_complex_signal(conf);
+
+    /* both transforms are done in place by cached plans */
+    roj_complex* buffer = roj_fftw(alloc_complex)(conf.length);
+    int byte_size = conf.length * sizeof(roj_complex);
+    memcpy(buffer, m_signal->m_waveform, byte_size);
+    roj_fft_plan_cache :: execute(conf.length, FFTW_FORWARD, buffer, buffer);
+
+    /* negative lines are removed (without fft shift) */
+    int first = conf.length/2 + conf.length%2;
     int half = conf.length/2;
-    for(int n=0; n<half; n++)
-      spectrum->m_spectrum[n] = 0.0;
-    m_equivalent = spectrum->get_signal();
-    delete spectrum;
+    memset(&buffer[first], 0x0, half * sizeof(roj_complex));
+
+    roj_fft_plan_cache :: execute(conf.length, FFTW_BACKWARD, buffer, m_equivalent->m_waveform);
+    roj_fftw(free)(buffer);
+
+    for (int n=0; n<conf.length; n++)  
+      m_equivalent->m_waveform[n] /= conf.length;
   }
   
   return m_equivalent;
@@ -28,6 +28,9 @@ struct roj_signal_config;
 #include "roj-fourier-spectr.hh"
 class roj_fourier_spectrum;
 
+#include "roj-fft-plan.hh"
+class roj_fft_plan_cache;
+
 /* ************************************************************************************************************************* */
 /* Hilbert equivalent class definition */
 
@@ -86,7 +86,7 @@ roj_real_array* roj_median_filter :: filtering (roj_real_array* a_arr, int a_hop
     call_error("hop not positive");
   }
   
-  double *buffer = new double[m_width];
+  roj_real *buffer = new roj_real[m_width];
 
   roj_array_config conf = a_arr->get_config();
   if(m_width>conf.length){
@@ -102,28 +102,28 @@ roj_real_array* roj_median_filter :: filtering (roj_real_array* a_arr, int a_hop
 
   roj_real_array* output = new roj_real_array(out_conf);
 
-  int byte_size = m_width * sizeof(double);
+  int byte_size = m_width * sizeof(roj_real);
   int half = (m_width-1) / 2;
 
   for(int n=0; n<out_conf.length; n++){
     memset(buffer, 0x0, byte_size);
     
     if(a_hop*n<half){      
-      int byte_size2 = (a_hop*n+half+1) * sizeof(double);
+      int byte_size2 = (a_hop*n+half+1) * sizeof(roj_real);
       memcpy(buffer, a_arr->m_data, byte_size2);
-      qsort(buffer, a_hop*n+half+1, sizeof(double), value_comparer);
+      qsort(buffer, a_hop*n+half+1, sizeof(roj_real), value_comparer);
       output->m_data[n] = buffer[(a_hop*n+half+1)/2];
     }
     else
       if(a_hop*n>=conf.length-half){      
-	int byte_size2 = (conf.length-a_hop*n+half) * sizeof(double);
+	int byte_size2 = (conf.length-a_hop*n+half) * sizeof(roj_real);
 	memcpy(buffer, &a_arr->m_data[a_hop*n-half-1], byte_size2);
-	qsort(buffer, conf.length-a_hop*n+half, sizeof(double), value_comparer);
+	qsort(buffer, conf.length-a_hop*n+half, sizeof(roj_real), value_comparer);
 	output->m_data[n] = buffer[(conf.length-a_hop*n+half)/2];
       }
       else{
 	memcpy(buffer, &a_arr->m_data[a_hop*n-half], byte_size);
-	qsort(buffer, m_width, sizeof(double), value_comparer);
+	qsort(buffer, m_width, sizeof(roj_real), value_comparer);
 	output->m_data[n] = buffer[half];	
       }
     
@@ -364,17 +364,108 @@ double calc_blackman_harris (int a_nr, int a_len, int a_d_order){
 /* ************************************************************************************************************************* */
 /**
 * @type: function
-* @brief: This routine is used for sorting and compares two double values.
+* @brief: This function allocates a matrix of real values as one contiguous, aligned and zeroed buffer. Rows are accessed by returned pointers. Each row starts at ROJ_ALIGNMENT boundary.
 *
-* @param [in] a_arg1: A pointer to double value.
-* @param [in] a_arg2: A pointer to double value.
+* @param [in] a_rows: A number of rows.
+* @param [in] a_cols: A number of columns (row length).
+*
+* @return: A pointer to row pointers. It has to be released by release_rows.
+*/
+roj_real** allocate_real_rows (int a_rows, int a_cols){
+
+  if(a_rows<1 or a_cols<1)
+    call_error("matrix size is not valid");
+  
+  int unit = ROJ_ALIGNMENT / sizeof(roj_real);
+  int stride = (a_cols + unit - 1) / unit * unit;
+  size_t byte_size = (size_t)a_rows * stride * sizeof(roj_real);
+
+  void* buffer;
+  if(posix_memalign(&buffer, ROJ_ALIGNMENT, byte_size) != 0)
+    call_error("memory cannot be allocated");
+  memset(buffer, 0x0, byte_size);
+  
+  roj_real** rows = new roj_real*[a_rows];
+  for(int n=0; n<a_rows; n++)
+    rows[n] = (roj_real*)buffer + (size_t)n * stride;
+
+  return rows;
+}
+
+/**
+* @type: function
+* @brief: This function allocates a matrix of complex values as one contiguous, aligned and zeroed buffer. Rows are accessed by returned pointers. Each row starts at ROJ_ALIGNMENT boundary.
+*
+* @param [in] a_rows: A number of rows.
+* @param [in] a_cols: A number of columns (row length).
+*
+* @return: A pointer to row pointers. It has to be released by release_rows.
+*/
+roj_complex** allocate_complex_rows (int a_rows, int a_cols){
+
+  if(a_rows<1 or a_cols<1)
+    call_error("matrix size is not valid");
+  
+  int unit = ROJ_ALIGNMENT / sizeof(roj_complex);
+  int stride = (a_cols + unit - 1) / unit * unit;
+  size_t byte_size = (size_t)a_rows * stride * sizeof(roj_complex);
+
+  void* buffer;
+  if(posix_memalign(&buffer, ROJ_ALIGNMENT, byte_size) != 0)
+    call_error("memory cannot be allocated");
+  memset(buffer, 0x0, byte_size);
+  
+  roj_complex** rows = new roj_complex*[a_rows];
+  for(int n=0; n<a_rows; n++)
+    rows[n] = (roj_complex*)buffer + (size_t)n * stride;
+
+  return rows;
+}
+
+/**
+* @type: function
+* @brief: This function releases a matrix allocated by allocate_real_rows.
+*
+* @param [in] a_rows: A pointer to row pointers.
+*/
+void release_rows (roj_real** a_rows){
+
+  if(a_rows==NULL)
+    return;
+  
+  free(a_rows[0]);
+  delete [] a_rows;
+}
+
+/**
+* @type: function
+* @brief: This function releases a matrix allocated by allocate_complex_rows.
+*
+* @param [in] a_rows: A pointer to row pointers.
+*/
+void release_rows (roj_complex** a_rows){
+
+  if(a_rows==NULL)
+    return;
+  
+  free(a_rows[0]);
+  delete [] a_rows;
+}
+
+/* ************************************************************************************************************************* */
+/**
+* @type: function
+* @brief: This routine is used for sorting and compares two real values (roj_real).
+*
+* @param [in] a_arg1: A pointer to a real value.
+* @param [in] a_arg2: A pointer to a real value.
 *
 * @return: The result of the comarison which is compatible with the 'qsort' function.
 */
 int value_comparer (const void * a_arg1, const void * a_arg2){
 
-  double _a = *(double*)a_arg1;
-  double _b = *(double*)a_arg2;
+  roj_real _a = *(roj_real*)a_arg1;
+  roj_real _b = *(roj_real*)a_arg2;
 
   if(_a < _b)
     return -1;
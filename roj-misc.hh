@@ -50,12 +50,122 @@
 */
 #define E_NUMBER 2.7182818284590452353602975
 
+/**
+* @type: define
+* @brief: This is an assumed size of L2 cache (in bytes). It is used to choose a number of STFT frames which are transformed in one batch.
+*/
+#define ROJ_L2_CACHE_SIZE 262144
+
+/**
+* @type: define
+* @brief: This is a default number of STFT columns calculated together by a stream. Memory used by a stream is proportional to this number.
+*/
+#define ROJ_STREAM_BLOCK 256
+
+/**
+* @type: define
+* @brief: STFT engine code. The engine is chosen automatically by an analyzer.
+*/
+#define ROJ_AUTO_ENGINE 0
+
+/**
+* @type: define
+* @brief: STFT engine code. Each frame is transformed by FFT of the bank length.
+*/
+#define ROJ_FFT_ENGINE 1
+
+/**
+* @type: define
+* @brief: STFT engine code. The FFT is pruned, so only lines of the analyzed band are calculated.
+*/
+#define ROJ_PRUNED_ENGINE 2
+
+/**
+* @type: define
+* @brief: STFT engine code. Lines are updated by the sliding DFT (for cosine-sum windows and small hops).
+*/
+#define ROJ_SLIDING_ENGINE 3
+
+/**
+* @type: define
+* @brief: This is the maximal order of cosine-sum windows handled by the sliding DFT.
+*/
+#define ROJ_COSINE_ORDER 4
+
+/**
+* @type: define
+* @brief: This is the maximal number of STFT columns calculated by the sliding DFT before its state is initialized again. It bounds the accumulation of rounding errors.
+*/
+#define ROJ_SLIDING_REFRESH 1024
+
+/**
+* @type: define
+* @brief: This is the maximal number of chirp-rates whose windows are kept by a worker of the STFT job. The cache is cleared when it is full.
+*/
+#define ROJ_WINDOW_CACHE 64
+
+/**
+* @type: define
+* @brief: This is an alignment (in bytes) of rows of matrices and STFT buffers. It fits cache lines and AVX-512 registers.
+*/
+#define ROJ_ALIGNMENT 64
+
+/**
+* @type: define
+* @brief: This is a number of filter channels which are processed together by the vectorized filter engine. All channels of a block are advanced by one sample at once.
+*/
+#define ROJ_FILTER_LANES 16
+
+/**
+* @type: define
+* @brief: This flag is defined if vectorized kernels can be compiled for many instruction sets (AVX-512, AVX2) and selected at runtime. It is available for gcc on x86.
+*/
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define ROJ_KERNEL_DISPATCH
+#endif
+
+/**
+* @type: define
+* @brief: This is a qualifier of kernel routines, which are inlined into variants of particular instruction sets.
+*/
+#define ROJ_KERNEL_INLINE static inline __attribute__((always_inline))
+
 /**
 * @type: define
 * @brief: Blackman-Harris window code.
 */
 #define ROJ_BH_WINDOW 0
 
+/**
+* @type: define
+* @brief: Hann window code (a periodic cosine sum).
+*/
+#define ROJ_HANN_WINDOW 1
+
+/**
+* @type: define
+* @brief: Generic cosine-sum window code. Coefficients are given by roj_window_generator :: set_cosine_coefs.
+*/
+#define ROJ_COSINE_WINDOW 2
+
+/**
+* @type: define
+* @brief: Gaussian window code. Its parameter is the standard deviation relative to the window duration.
+*/
+#define ROJ_GAUSS_WINDOW 3
+
+/**
+* @type: define
+* @brief: Kaiser window code. Its parameter is the shape factor (beta).
+*/
+#define ROJ_KAISER_WINDOW 4
+
+/**
+* @type: define
+* @brief: DPSS (Slepian) window code. Its parameter is the time-half-bandwidth product (NW).
+*/
+#define ROJ_DPSS_WINDOW 5
+
 /**
  * @type: define
  * @brief: ODE filter type code
@@ -74,6 +184,27 @@
  */
 #define ROJ_DEBUG_PROMPT "\033[1;31m(debug)\033[0m"
 
+/* ************************************************************************************************************************* */
+/* scalar types */
+
+/**
+ * @type: define
+ * @brief: Define this flag (make ROJ_SINGLE_PRECISION=1) if you want to store signals, spectra and distributions in single precision. Memory and bandwidth used by STFT slots and images are halved and fftwf plans are used. Recursive filters, sliding DFT trackers and time axes are still calculated in double precision. Chirp-rate estimates are less accurate in this mode.
+ *
+ * roj_real and roj_complex are scalar types of samples and pixels, roj_fftw(name) selects a FFTW routine of the same precision and ROJ_NO_ESTIMATE is a value of pixels without an estimate.
+ */
+#ifdef ROJ_SINGLE_PRECISION
+typedef float roj_real;
+typedef complex float roj_complex;
+#define roj_fftw(name) fftwf_ ## name
+#define ROJ_NO_ESTIMATE ((roj_real)1E38)
+#else
+typedef double roj_real;
+typedef complex double roj_complex;
+#define roj_fftw(name) fftw_ ## name
+#define ROJ_NO_ESTIMATE ((roj_real)1E300)
+#endif
+
 /* Blackman Harris window coefficents*/
 #define WIN_BH_0  0.3232153788877343
 #define WIN_BH_1 -0.4714921439576260
@@ -81,6 +212,11 @@
 #define WIN_BH_3 -0.02849699010614994
 #define WIN_BH_4  0.001261357088292677
 
+/* default parameters of windows */
+#define WIN_GAUSS_SIGMA 0.125
+#define WIN_KAISER_BETA 12.0
+#define WIN_DPSS_NW 4.0
+
 /* ************************************************************************************************************************* */
 /* structure definitions */
 
@@ -161,6 +297,12 @@ int calc_factorial(int);
 /* windows */
 double calc_blackman_harris(int, int, int =0);
 
+/* contiguous matrix storage */
+roj_real** allocate_real_rows (int, int);
+roj_complex** allocate_complex_rows (int, int);
+void release_rows (roj_real**);
+void release_rows (roj_complex**);
+
 /* others */
 int value_comparer (const void*, const void*);
 double calc_4x4_det (double [4][4]);
@@ -54,11 +54,12 @@ roj_ode_analyzer :: roj_ode_analyzer(roj_array_config a_bank_conf, roj_filter_ge
 
   m_filter_gen->set_order(a_filter_gen->get_order());
   m_input_signal = NULL;
+  m_threads = 1;
+  m_cascade = NULL;
 
-  /* allocate slots */
-  m_filtered_signals = new roj_complex_signal**[5];
+  /* slots are allocated by filtering */
   for(int n=0; n<5; n++)
-    m_filtered_signals[n] = NULL;
+    m_filtered_images[n] = NULL;
 }
 
 /**
@@ -67,19 +68,14 @@ roj_ode_analyzer :: roj_ode_analyzer(roj_array_config a_bank_conf, roj_filter_ge
  */
 roj_ode_analyzer :: ~roj_ode_analyzer(){
   
-  for(int n=0; n<5; n++){  
-    if (m_filtered_signals[n]!=NULL){
-
-      for(int k=0; k<m_bank_config.length; k++)
-	delete m_filtered_signals[n][k];      
-      delete [] m_filtered_signals[n];
-    }
-  }
-  delete [] m_filtered_signals;
+  for(int n=0; n<5; n++)
+    if (m_filtered_images[n]!=NULL)
+      release_rows(m_filtered_images[n]);
   
   for(int n=0; n<5; n++)
     delete m_bank_array[n];
   delete [] m_bank_array;
+  delete m_cascade;
 
   delete m_filter_gen;
 }
@@ -104,6 +100,81 @@ void roj_ode_analyzer :: set_signal(roj_complex_signal* a_sig, int a_hop){
 }
 
 
+/**
+ * @type: method
+ * @brief: This function sets a number of worker threads. Channels of all filtered banks are distributed between threads.
+ *
+ * @param [in] a_threads (default 1): A number of threads.
+ */
+void roj_ode_analyzer :: set_threads (unsigned int a_threads){
+
+  if(a_threads<1){
+    call_warning("in roj_ode_analyzer :: set_threads");
+    call_error("number of threads < 1");
+  }
+  
+  m_threads = a_threads;
+}
+
+/**
+ * @type: method
+ * @brief: This function switches filtering by a shared-pole cascade. Filters of all five banks at a given channel have the same pole, so their outputs are taps of one cascade of first-order sections (see roj_ode_decimator). All banks are filtered by one recursion and, for hop>1, outputs are calculated only for retained samples. Filters of the generator cannot have additional output delay.
+ *
+ * @param [in] a_cascade (default true): True if the cascade is used instead of separate banks.
+ */
+void roj_ode_analyzer :: set_cascade (bool a_cascade){
+
+  delete m_cascade;
+  m_cascade = NULL;
+
+  if(a_cascade){
+
+    if(m_filter_gen->get_delay()!=1){
+      call_warning("in roj_ode_analyzer :: set_cascade");
+      call_error("cascade requires filters without output delay");
+    }
+
+    /* taps of orders from N-2 to N+2 */
+    unsigned int order = m_filter_gen->get_order();
+    m_filter_gen->set_order(order + 2);
+    m_cascade = m_filter_gen->get_ode_decimator(m_bank_config, 5);
+    m_filter_gen->set_order(order);
+  }
+}
+
+/**
+ * @type: private
+ * @brief: This function filters the input signal by banks of a given range, which are not filtered yet. Channels of all these banks are items of one job, so threads are busy even if a single bank is filtered. If the cascade is set, all missing banks are obtained as its taps. Outputs of each bank are stored in one time-major block, so blocks of channels are written side by side into rows.
+ *
+ * @param [in] a_first: An index of the first bank.
+ * @param [in] a_last: An index of the last bank.
+ */
+void roj_ode_analyzer :: filtering (int a_first, int a_last){
+
+  roj_filter_job job(m_input_signal, m_hop);
+  roj_complex** taps[5] = {NULL, NULL, NULL, NULL, NULL};
+  bool missing = false;
+
+  for(int n=a_first; n<=a_last; n++)
+    if(m_filtered_images[n] == NULL){
+      m_filtered_images[n] = allocate_complex_rows(get_width(), get_height());
+      missing = true;
+
+      if(m_cascade!=NULL)
+	taps[n] = m_filtered_images[n];
+      else
+	job.add_bank(m_bank_array[n], m_filtered_images[n]);
+    }
+
+  /* the cascade starts from zero states for each pass over the signal */
+  if(m_cascade!=NULL and missing){
+    m_cascade->reset();
+    job.add_decimator(m_cascade, taps);
+  }
+
+  job.run(m_threads);
+}
+
 /* ************************************************************************************************************************* */
 /**
  * @type: method
@@ -137,13 +208,9 @@ unsigned int roj_ode_analyzer :: get_width(){
     call_error("signal is not loaded!");
   }
 
-  /* filtering */
-  if(m_filtered_signals[2] == NULL)
-    m_filtered_signals[2] = m_bank_array[2]->filtering(m_input_signal, m_hop);  
-
-  /* get length from first signal */  
-  roj_signal_config conf = m_filtered_signals[2][0]->get_config();  
-  return conf.length;
+  /* each hop-th sample is retained */
+  roj_signal_config conf = m_input_signal->get_config();  
+  return conf.length / m_hop;
 }
 
 /**
@@ -173,11 +240,11 @@ roj_image_config roj_ode_analyzer :: get_image_config (){
     call_error("signal is not loaded!");
   }
   
-  /* filtering  (2 bank) */
-  if(m_filtered_signals[2] == NULL)
-    m_filtered_signals[2] = m_bank_array[2]->filtering(m_input_signal, m_hop);  
-
-  roj_signal_config sig_conf = m_filtered_signals[2][0]->get_config();
+  /* time of the first retained sample */
+  roj_signal_config sig_conf = m_input_signal->get_config();
+  sig_conf.start += (double)(m_hop-1) / sig_conf.rate;
+  sig_conf.length /= m_hop;
+  sig_conf.rate /= m_hop;
 
   roj_image_config img_conf;
   img_conf.y.length = get_height();
@@ -228,17 +295,14 @@ roj_stft_transform* roj_ode_analyzer :: get_transform_as_stft (){
   }
 
   /* filtering  (2 bank) */
-  if(m_filtered_signals[2] == NULL)
-    m_filtered_signals[2] = m_bank_array[2]->filtering(m_input_signal, m_hop);  
+  filtering(2, 2);
 
   roj_image_config img_conf = get_image_config ();  
   roj_stft_transform* transform = new roj_stft_transform(img_conf, NULL);
 
   /* calc stft */
   for(int n=0; n<get_width(); n++){
-    for(int k=0; k<get_height(); k++)
-      transform->m_spectrum[n][k] =  m_filtered_signals[2][k]->m_waveform[n];
-
+    memcpy(transform->m_spectrum[n], m_filtered_images[2][n], get_height() * sizeof(roj_complex));
     print_progress(n+1, get_width(), "stft");
   }
   print_progress(0, 0, "stft");
@@ -262,8 +326,7 @@ roj_real_matrix* roj_ode_analyzer :: get_spectral_energy(){
   }
 
   /* filtering  (2 bank) */
-  if(m_filtered_signals[2] == NULL)
-    m_filtered_signals[2] = m_bank_array[2]->filtering(m_input_signal, m_hop);  
+  filtering(2, 2);
   
   /* make empty output object */
   roj_real_matrix* output = create_empty_image();
@@ -271,7 +334,7 @@ roj_real_matrix* roj_ode_analyzer :: get_spectral_energy(){
   /* calc energy estimate */
   for(int n=0; n<get_width(); n++){
     for(int k=0; k<get_height(); k++)
-      output->m_data[n][k] = pow(cabs(m_filtered_signals[2][k]->m_waveform[n]), 2.0);
+      output->m_data[n][k] = pow(cabs(m_filtered_images[2][n][k]), 2.0);
 
     print_progress(n+1, get_width(), "energy");
   }
@@ -280,6 +343,114 @@ roj_real_matrix* roj_ode_analyzer :: get_spectral_energy(){
   return output;
 }
 
+/* ************************************************************************************************************************* */
+/**
+ * @type: private
+ * @brief: This function calculates requested distributions from filtered signals. Slots of a column are derived from available banks (see roj_ode_decimator :: get_estimator_lines) and the estimator kernel processes the column, so filtered rows are read and distribution rows are written in memory order.
+ *
+ * @param [in] a_images: Output distributions (NULL pointers are skipped). Required banks have to be filtered.
+ * @param [in] a_name: A label of progress messages.
+ */
+void roj_ode_analyzer :: estimating(roj_estimator_images a_images, const char* a_name){
+
+  int width = get_width();
+  int height = get_height();
+  double spread = m_filter_gen->get_spread();
+  double order = m_filter_gen->get_order();
+
+  /* buffers of a column */
+  roj_complex** slots = allocate_complex_rows(5, height);
+  roj_estimator_kernel kernel(height);
+
+  /* TODO: include to filter bank */
+  complex double* poles = new complex double [height];
+  for(int k=0; k<height; k++)
+    poles[k] = I*TWO_PI * m_bank_array[2]->get_frequency(k) -1.0/spread;
+
+  for(int n=0; n<width; n++){
+
+    /* rows of filtered banks at a time instant */
+    roj_complex* w[5];
+    for(int o=0; o<5; o++)
+      w[o] = m_filtered_images[o] ? m_filtered_images[o][n] : NULL;
+
+    roj_estimator_maps maps;
+    maps.energy = get_column(a_images.energy, n);
+    maps.ifreq_1 = get_column(a_images.ifreq_1, n);
+    maps.ifreq_2 = get_column(a_images.ifreq_2, n);
+    maps.delay = get_column(a_images.delay, n);
+    maps.k_rate = get_column(a_images.k_rate, n);
+    maps.m_rate = get_column(a_images.m_rate, n);
+    maps.d_rate = get_column(a_images.d_rate, n);
+    maps.f_rate = get_column(a_images.f_rate, n);
+    maps.dof = get_column(a_images.dof, n);
+
+    roj_estimator_lines lines = roj_ode_decimator :: get_estimator_lines(w, poles, spread, order, height, slots);
+    kernel.calc(lines, maps);
+    print_progress(n+1, width, a_name);
+  }
+  
+  print_progress(0, 0, a_name);
+  delete [] poles;
+  release_rows(slots);
+}
+
+/**
+ * @type: private
+ * @brief: This function returns a column of a distribution.
+ *
+ * @param [in] a_image: A distribution (it can be NULL).
+ * @param [in] a_column: A column index.
+ *
+ * @return: A pointer to the column or NULL if the distribution is NULL.
+ */
+roj_real* roj_ode_analyzer :: get_column(roj_real_matrix* a_image, int a_column){
+
+  if(a_image==NULL)
+    return NULL;
+  return a_image->m_data[a_column];
+}
+
+/* ************************************************************************************************************************* */
+/**
+ * @type: method
+ * @brief: This function returns many distributions at once. Missing banks are filtered, then all distributions are obtained in one pass over channels.
+ *
+ * @param [in] a_mask: A bitwise or of DIST_* codes.
+ *
+ * @return: A structure with pointers to obtained distributions (NULL if not requested). They have to be released by the caller.
+ */
+roj_estimator_images roj_ode_analyzer :: get_distributions(int a_mask){
+
+  /* check input signal */
+  if(m_input_signal==NULL){
+    call_warning("in roj_ode_analyzer :: get_distributions");
+    call_error("signal is not loaded!");
+  }
+
+  /* required banks (they form a range around bank 2) */
+  int first, last;
+  roj_ode_decimator :: get_tap_range(a_mask, &first, &last);
+
+  /* filtering */
+  filtering(first, last);
+
+  /* make empty output objects */
+  roj_estimator_images images;
+  images.energy = a_mask & DIST_ENERGY ? create_empty_image() : NULL;
+  images.ifreq_1 = a_mask & DIST_IFREQ_1 ? create_empty_image() : NULL;
+  images.ifreq_2 = a_mask & DIST_IFREQ_2 ? create_empty_image() : NULL;
+  images.delay = a_mask & DIST_DELAY ? create_empty_image() : NULL;
+  images.k_rate = a_mask & DIST_CR_K ? create_empty_image() : NULL;
+  images.m_rate = a_mask & DIST_CR_M ? create_empty_image() : NULL;
+  images.d_rate = a_mask & DIST_CR_D ? create_empty_image() : NULL;
+  images.f_rate = a_mask & DIST_CR_F ? create_empty_image() : NULL;
+  images.dof = a_mask & DIST_DOF ? create_empty_image() : NULL;
+
+  estimating(images, "dists");
+  return images;
+}
+
 /* ************************************************************************************************************************* */
 /**
  * @type: method
@@ -296,37 +467,17 @@ roj_real_matrix* roj_ode_analyzer :: get_instantaneous_frequency_by_1_estimator(
   }
 
   /* filtering  (1 and 2 banks) */
-  for(int n=1; n<3; n++)
-    if(m_filtered_signals[n] == NULL)
-      m_filtered_signals[n] = m_bank_array[n]->filtering(m_input_signal, m_hop);  
+  filtering(1, 2);
   
   /* make empty output object */
   roj_real_matrix* output = create_empty_image();
 
   /* calc instantaneous frequency estimate */
-  for(int k=0; k<get_height(); k++){
+  roj_estimator_images images;
+  memset(&images, 0x0, sizeof(roj_estimator_images));
+  images.ifreq_1 = output;
+  estimating(images, "i-freq");
 
-    /* TODO: include to filter bank */
-    double frequency = m_bank_array[2]->get_frequency(k);
-    complex double pole = I*TWO_PI * frequency -1.0/m_filter_gen->get_spread();
-
-    for(int n=0; n<get_width(); n++){
-
-      /* TODO: include to filter bank */
-      complex double y = m_filtered_signals[2][k]->m_waveform[n]; 
-      complex double yD = m_filtered_signals[1][k]->m_waveform[n] / m_filter_gen->get_spread();
-      yD += m_filtered_signals[2][k]->m_waveform[n] * pole;
-
-      if(cabs(y)==0)
-	output->m_data[n][k] = 1E300;
-      else
-	output->m_data[n][k] = cimag(yD/y) / TWO_PI;
-    }    
-
-    print_progress(k+1, m_bank_config.length, "i-freq");
-  }
-
-  print_progress(0, 0, "i-freq");    
   return output;
 }
 
@@ -345,39 +496,17 @@ roj_real_matrix* roj_ode_analyzer :: get_instantaneous_frequency_by_2_estimator(
   }
 
   /* filtering  (1 - 3 banks) */
-  for(int n=1; n<4; n++)
-    if(m_filtered_signals[n] == NULL)
-      m_filtered_signals[n] = m_bank_array[n]->filtering(m_input_signal, m_hop);  
+  filtering(1, 3);
   
   /* make empty output object */
   roj_real_matrix* output = create_empty_image();
 
   /* calc instantaneous frequency estimate */
-  for(int k=0; k<get_height(); k++){
-
-    /* TODO: include to filter bank */
-    double frequency = m_bank_array[2]->get_frequency(k);
-    complex double pole = I*TWO_PI * frequency -1.0/m_filter_gen->get_spread();
-
-    for(int n=0; n<get_width(); n++){
-
-      /* TODO: include to filter bank */
-      complex double y = m_filtered_signals[2][k]->m_waveform[n]; 
-      complex double yD = m_filtered_signals[1][k]->m_waveform[n] / m_filter_gen->get_spread();
-      yD += m_filtered_signals[2][k]->m_waveform[n] * pole;
-
-      complex double yT = m_filtered_signals[3][k]->m_waveform[n] * m_filter_gen->get_spread() * m_filter_gen->get_order();
-
-      if(cabs(y)==0)
-	output->m_data[n][k] = 1E300;
-      else
-	output->m_data[n][k] = -(creal(yD/yT)/cimag(y/yT)) / TWO_PI;
-    }    
-
-    print_progress(k+1, m_bank_config.length, "i-freq");
-  }
+  roj_estimator_images images;
+  memset(&images, 0x0, sizeof(roj_estimator_images));
+  images.ifreq_2 = output;
+  estimating(images, "i-freq");
 
-  print_progress(0, 0, "i-freq");    
   return output;
 }
 
@@ -397,28 +526,17 @@ roj_real_matrix* roj_ode_analyzer :: get_spectral_delay(){
   }
 
   /* filtering  (2 and 3 banks) */
-  for(int n=2; n<4; n++)
-    if(m_filtered_signals[n] == NULL)
-      m_filtered_signals[n] = m_bank_array[n]->filtering(m_input_signal, m_hop);  
+  filtering(2, 3);
 
   /* make empty output object */
   roj_real_matrix* output = create_empty_image();
 
   /* calc spectral delay estimate */
-  for(int k=0; k<get_height(); k++){
-    for(int n=0; n<get_width(); n++){
-      
-      /* TODO: include to filter bank */
-      complex double y = m_filtered_signals[2][k]->m_waveform[n]; 
-      complex double yT = m_filtered_signals[3][k]->m_waveform[n] * m_filter_gen->get_spread() * m_filter_gen->get_order();
-      
-      output->m_data[n][k] = -creal(yT/y); 
-    }
-
-    print_progress(k+1, m_bank_config.length, "s-delay");
-  }
+  roj_estimator_images images;
+  memset(&images, 0x0, sizeof(roj_estimator_images));
+  images.delay = output;
+  estimating(images, "s-delay");
 
-  print_progress(0, 0, "s-delay");
   return output;
 }
 
@@ -438,41 +556,17 @@ roj_real_matrix* roj_ode_analyzer :: get_chirp_rate_by_k_estimator(){
   }
 
   /* filtering  (1 - 3 banks) */
-  for(int n=1; n<4; n++)
-    if(m_filtered_signals[n] == NULL)
-      m_filtered_signals[n] = m_bank_array[n]->filtering(m_input_signal, m_hop);  
+  filtering(1, 3);
   
   /* make empty output object */
   roj_real_matrix* output = create_empty_image();
 
   /* calc chirp rate estimate */
-  for(int k=0; k<get_height(); k++){
-
-    /* TODO: include to filter bank */
-    double frequency = m_bank_array[2]->get_frequency(k);
-    complex double pole = I*TWO_PI * frequency -1.0/m_filter_gen->get_spread();
-
-    for(int n=0; n<get_width(); n++){
-      
-      /* TODO: include to filter bank */
-      complex double y = m_filtered_signals[2][k]->m_waveform[n]; 
-      complex double yT = m_filtered_signals[3][k]->m_waveform[n] * m_filter_gen->get_spread() * m_filter_gen->get_order();      
-      complex double yD = m_filtered_signals[1][k]->m_waveform[n] / m_filter_gen->get_spread();
-      yD += m_filtered_signals[2][k]->m_waveform[n] * pole;
-
-      double nominative = creal(yD/y) / TWO_PI;
-      double denominative = cimag(yT/y); 
-
-      if(cabs(y)==0)
-	output->m_data[n][k] = 1E300;
-      else
-	output->m_data[n][k] = nominative / denominative;
-    }
-
-    print_progress(k+1, m_bank_config.length, "c-rate");
-  }
+  roj_estimator_images images;
+  memset(&images, 0x0, sizeof(roj_estimator_images));
+  images.k_rate = output;
+  estimating(images, "c-rate");
 
-  print_progress(0, 0, "c-rate");
   return output;
 }
 
@@ -491,49 +585,17 @@ roj_real_matrix* roj_ode_analyzer :: get_chirp_rate_by_d_estimator(){
   }
 
   /* filtering  (0 - 3 banks) */
-  for(int n=0; n<4; n++)
-    if(m_filtered_signals[n] == NULL)
-      m_filtered_signals[n] = m_bank_array[n]->filtering(m_input_signal, m_hop);  
+  filtering(0, 3);
 
   /* make empty output object */
   roj_real_matrix* output = create_empty_image();
 
   /* calc chirp rate estimate */
-  for(int k=0; k<get_height(); k++){
-    
-    /* TODO: include to filter bank */
-    double frequency = m_bank_array[2]->get_frequency(k);
-    complex double pole = I*TWO_PI * frequency -1.0/m_filter_gen->get_spread();
-
-    for(int n=0; n<get_width(); n++){
-      
-      /* TODO: include to filter bank */
-      complex double y = m_filtered_signals[2][k]->m_waveform[n]; 
-      complex double y2 = cpow(m_filtered_signals[2][k]->m_waveform[n], 2.0); 
-      complex double yT = m_filtered_signals[3][k]->m_waveform[n] * m_filter_gen->get_spread() * m_filter_gen->get_order();      
-      complex double yD = m_filtered_signals[1][k]->m_waveform[n] / m_filter_gen->get_spread();
-      yD += m_filtered_signals[2][k]->m_waveform[n] * pole;
-      
-      complex double yDT = m_filtered_signals[2][k]->m_waveform[n] * m_filter_gen->get_order();
-      yDT += m_filtered_signals[3][k]->m_waveform[n] * m_filter_gen->get_order() * m_filter_gen->get_spread() * pole;
-      
-      complex double yD2 = m_filtered_signals[0][k]->m_waveform[n] / pow(m_filter_gen->get_spread(), 2.0);
-      yD2 += 2.0 * pole * m_filtered_signals[1][k]->m_waveform[n] / m_filter_gen->get_spread();
-      yD2 += cpow(pole, 2.0) * m_filtered_signals[2][k]->m_waveform[n];
-      
-      double nominative = creal (yD2/y - yD*yD/y2) / TWO_PI;
-      double denominative = cimag (yDT/y - yD*yT/y2);
-
-      if(cabs(y)==0)
-	output->m_data[n][k] = 1E300;
-      else
-	output->m_data[n][k] = nominative / denominative;
-    }
-    
-    print_progress(k+1, m_bank_config.length, "c-rate");
-  }
-  
-  print_progress(0, 0, "c-rate");
+  roj_estimator_images images;
+  memset(&images, 0x0, sizeof(roj_estimator_images));
+  images.d_rate = output;
+  estimating(images, "c-rate");
+
   return output;
 }
 
@@ -555,48 +617,17 @@ roj_real_matrix* roj_ode_analyzer :: get_chirp_rate_by_f_estimator(){
   }
 
   /* filtering  (1 - 4 banks) */
-  for(int n=1; n<5; n++)
-    if(m_filtered_signals[n] == NULL)
-      m_filtered_signals[n] = m_bank_array[n]->filtering(m_input_signal, m_hop);  
+  filtering(1, 4);
 
   /* make empty output object */
   roj_real_matrix* output = create_empty_image();
 
   /* calc chirp rate estimate */
-  for(int k=0; k<get_height(); k++){
-    
-    /* TODO: include to filter bank */
-    double frequency = m_bank_array[2]->get_frequency(k);
-    complex double pole = I*TWO_PI * frequency -1.0/m_filter_gen->get_spread();
-
-    for(int n=0; n<get_width(); n++){
- 
-    /* TODO: include to filter bank */
-      complex double y = m_filtered_signals[2][k]->m_waveform[n]; 
-      complex double y2 = cpow(m_filtered_signals[2][k]->m_waveform[n], 2.0); 
-      complex double yT = m_filtered_signals[3][k]->m_waveform[n] * m_filter_gen->get_spread() * m_filter_gen->get_order();      
-      complex double yD = m_filtered_signals[1][k]->m_waveform[n] / m_filter_gen->get_spread();
-      yD += m_filtered_signals[2][k]->m_waveform[n] * pole;
-      
-      complex double yDT = m_filtered_signals[2][k]->m_waveform[n] * m_filter_gen->get_order();
-      yDT += m_filtered_signals[3][k]->m_waveform[n] * m_filter_gen->get_order() * m_filter_gen->get_spread() * pole;
-      
-      complex double yT2 = m_filter_gen->get_order() * (m_filter_gen->get_order() + 1) * m_filtered_signals[4][k]->m_waveform[n];
-      yT2 *= pow(m_filter_gen->get_spread(), 2.0);
-      
-      double nominative = cimag (yDT/y - yD*yT/y2) / TWO_PI;
-      double denominative = creal (yT2/y - yT*yT/y2);
-
-      if(cabs(y)==0)
-	output->m_data[n][k] = 1E300;
-      else
-	output->m_data[n][k] = -nominative / denominative;
-    }
+  roj_estimator_images images;
+  memset(&images, 0x0, sizeof(roj_estimator_images));
+  images.f_rate = output;
+  estimating(images, "c-rate");
 
-    print_progress(k+1, m_bank_config.length, "c-rate");
-  }
-  
-  print_progress(0, 0, "c-rate");
   return output;
 }
 
@@ -616,46 +647,16 @@ roj_real_matrix* roj_ode_analyzer :: get_chirp_rate_by_m_estimator(){
   }
 
   /* filtering  (0 - 4 banks) */
-  for(int n=0; n<5; n++)
-    if(m_filtered_signals[n] == NULL)
-      m_filtered_signals[n] = m_bank_array[n]->filtering(m_input_signal, m_hop);  
+  filtering(0, 4);
 
   /* make empty output object */
   roj_real_matrix* output = create_empty_image();
 
   /* calc chirp rate estimate */
-  for(int k=0; k<get_height(); k++){
-    
-    /* TODO: include to filter bank */
-    double frequency = m_bank_array[2]->get_frequency(k);
-    complex double pole = I*TWO_PI * frequency -1.0/m_filter_gen->get_spread();
-
-    for(int n=0; n<get_width(); n++){
-      
-      /* TODO: include to filter bank */
-      complex double yT = m_filtered_signals[3][k]->m_waveform[n] * m_filter_gen->get_spread() * m_filter_gen->get_order();      
-      complex double yD = m_filtered_signals[1][k]->m_waveform[n] / m_filter_gen->get_spread();
-      yD += m_filtered_signals[2][k]->m_waveform[n] * pole;
-      
-      complex double yT2 = m_filter_gen->get_order() * (m_filter_gen->get_order() + 1) * m_filtered_signals[4][k]->m_waveform[n];
-      yT2 *= pow(m_filter_gen->get_spread(), 2.0);
-
-      complex double yD2 = m_filtered_signals[0][k]->m_waveform[n] / pow(m_filter_gen->get_spread(), 2.0);
-      yD2 += 2.0 * pole * m_filtered_signals[1][k]->m_waveform[n] / m_filter_gen->get_spread();
-      yD2 += cpow(pole, 2.0) * m_filtered_signals[2][k]->m_waveform[n];
-      
-      double nominative = creal (yD2/yD) / TWO_PI;
-      double denominative = cimag (yT2/yT);
-
-      if(cabs(yT)==0 or cabs(yD)==0 or cabs(yT2)==0)
-	output->m_data[n][k] = 1E300;
-      else
-	output->m_data[n][k] = nominative / denominative;
-    }
-    
-    print_progress(k+1, m_bank_config.length, "c-rate");
-  }
-  
-  print_progress(0, 0, "c-rate");
+  roj_estimator_images images;
+  memset(&images, 0x0, sizeof(roj_estimator_images));
+  images.m_rate = output;
+  estimating(images, "c-rate");
+
   return output;
 }
@@ -25,6 +25,12 @@ class tf_analyzer;
 #include "roj-filter-bank.hh"
 class roj_filter_bank;
 
+#include "roj-estim-kernel.hh"
+class roj_estimator_kernel;
+
+#include "roj-ode-decim.hh"
+class roj_ode_decimator;
+
 /* ************************************************************************************************************************* */
 /* filter analyzer class definition */
 
@@ -35,15 +41,26 @@ private:
   /* filter generator */
   roj_filter_generator* m_filter_gen;
 
-  /* filters and filtered signals slots */
-  roj_complex_signal*** m_filtered_signals;
+  /* filters and filtered signals slots (time-major, a row for each retained sample) */
+  roj_complex** m_filtered_images[5];
   roj_filter_bank** m_bank_array;
+  unsigned int m_threads;
+
+  /* shared-pole cascade of all banks (NULL if banks are used) */
+  roj_ode_decimator* m_cascade;
+
+  /* filter missing banks by a common job */
+  void filtering(int, int);
 
   /* width depends on signal length 
      height on filter number */
   unsigned int get_height();
   unsigned int get_width();
 
+  /* calc distributions by estimator kernel */
+  void estimating(roj_estimator_images, const char*);
+  roj_real* get_column(roj_real_matrix*, int);
+
 public:
 
   /* construction */
@@ -51,6 +68,8 @@ public:
   ~roj_ode_analyzer();  
 
   void set_signal(roj_complex_signal*, int =1);
+  void set_threads(unsigned int =1);
+  void set_cascade(bool =true);
   double get_frequency(unsigned int =0);
   
   roj_image_config get_image_config ();
@@ -68,6 +87,8 @@ public:
   
   roj_real_matrix* get_chirp_rate_by_d_estimator();
   roj_real_matrix* get_chirp_rate_by_f_estimator();
+
+  roj_estimator_images get_distributions(int);
 };
 
 #endif
@@ -0,0 +1,495 @@
+/* *************************************************** *
+ * This file is a part of ccROJ project (version 0-49) *
+ * distributed under GNU General Public License v3.0.  *
+ * Please visit the webpage: github.com/dsp-box/ccROJ  *
+ * for more information.                               *
+ *                       contact: Krzysztof Czarnecki  *
+ *                email: czarnecki.krzysiek@gmail.com  *
+ * *************************************************** */
+
+
+#include "roj-ode-decim.hh"
+#include "roj-filter-lanes.hh"
+#include "roj-analyzer.hh"
+
+/* ************************************************************************************************************************* */
+/**
+* @type: function
+* @brief: This routine filters a signal by lanes of a decimator. Outputs of taps are calculated only for each hop-th sample.
+*
+* @param [in] a_lanes: A number of processed lanes.
+* @param [in] a_count: A number of used lanes (channels).
+* @param [in] a_sections: A number of processed sections (an order of the highest requested tap).
+* @param [in] a_taps: A number of taps.
+* @param [in] a_low: An order of the first tap.
+* @param [in] a_weights: Weights of sections for each tap.
+* @param [in] a_alpha_re: Real parts of poles.
+* @param [in] a_alpha_im: Imaginary parts of poles.
+* @param [in, out] a_state_re: Real parts of section states.
+* @param [in, out] a_state_im: Imaginary parts of section states.
+* @param [out] a_sums: A buffer for real and imaginary parts of outputs (2*lanes elements).
+* @param [in] a_samples: Input samples.
+* @param [in] a_length: A number of input samples.
+* @param [out] a_outputs: Output waveforms of taps (one for each used lane, NULL if a tap is not requested).
+* @param [in] a_hop: A hopsize.
+* @param [in] a_phase: A number of samples processed after the last retained sample.
+* @param [in] a_stride: A distance between consecutive output samples of a waveform.
+*/
+ROJ_KERNEL_INLINE void decimate_lanes (int a_lanes, int a_count, int a_sections, int a_taps, int a_low, double** a_weights,
+				       const double* a_alpha_re, const double* a_alpha_im, double** a_state_re, double** a_state_im,
+				       double* a_sums, const roj_complex* a_samples, int a_length, roj_complex*** a_outputs, int a_hop, int a_phase, int a_stride){
+
+  const double* __restrict__ ar = a_alpha_re;
+  const double* __restrict__ ai = a_alpha_im;
+
+  for(int n=0; n<a_length; n++){
+
+    double xr = creal(a_samples[n]);
+    double xi = cimag(a_samples[n]);
+
+    /* the first section: v(0) = alpha v(0) + x */
+    {
+      double* __restrict__ vr = a_state_re[0];
+      double* __restrict__ vi = a_state_im[0];
+
+      for(int c=0; c<a_lanes; c++){
+	double re = vr[c];
+	double im = vi[c];
+	vr[c] = (ar[c]*re - ai[c]*im) + xr;
+	vi[c] = (ar[c]*im + ai[c]*re) + xi;
+      }
+    }
+
+    /* next sections: v(k) = alpha v(k) + v(k-1) */
+    for(int k=1; k<a_sections; k++){
+      double* __restrict__ vr = a_state_re[k];
+      double* __restrict__ vi = a_state_im[k];
+      const double* __restrict__ ur = a_state_re[k-1];
+      const double* __restrict__ ui = a_state_im[k-1];
+
+      for(int c=0; c<a_lanes; c++){
+	double re = vr[c];
+	double im = vi[c];
+	vr[c] = (ar[c]*re - ai[c]*im) + ur[c];
+	vi[c] = (ar[c]*im + ai[c]*re) + ui[c];
+      }
+    }
+
+    /* retained outputs: weighted sums of sections */
+    if((n+a_phase)%a_hop == a_hop-1){
+      for(int t=0; t<a_taps; t++){
+	if(a_outputs[t]==NULL)
+	  continue;
+
+	double* __restrict__ yr = a_sums;
+	double* __restrict__ yi = a_sums + a_lanes;
+	for(int c=0; c<a_lanes; c++){
+	  yr[c] = 0.0;
+	  yi[c] = 0.0;
+	}
+
+	for(int k=0; k<a_low+t; k++){
+	  double weight = a_weights[t][k];
+	  const double* __restrict__ vr = a_state_re[k];
+	  const double* __restrict__ vi = a_state_im[k];
+
+	  for(int c=0; c<a_lanes; c++){
+	    yr[c] += weight * vr[c];
+	    yi[c] += weight * vi[c];
+	  }
+	}
+
+	for(int c=0; c<a_count; c++){
+	  roj_complex* sample = &a_outputs[t][c][(size_t)((n+a_phase)/a_hop) * a_stride];
+	  __real__ *sample = yr[c];
+	  __imag__ *sample = yi[c];
+	}
+      }
+    }
+  }
+}
+
+/* instruction set variants */
+
+#ifdef ROJ_KERNEL_DISPATCH
+__attribute__((target("avx512f,avx512dq"), optimize("tree-vectorize")))
+static void decimate_lanes_avx512 (int a_lanes, int a_count, int a_sections, int a_taps, int a_low, double** a_weights,
+				   const double* a_alpha_re, const double* a_alpha_im, double** a_state_re, double** a_state_im,
+				   double* a_sums, const roj_complex* a_samples, int a_length, roj_complex*** a_outputs, int a_hop, int a_phase, int a_stride){
+
+  decimate_lanes(a_lanes, a_count, a_sections, a_taps, a_low, a_weights, a_alpha_re, a_alpha_im, a_state_re, a_state_im, a_sums, a_samples, a_length, a_outputs, a_hop, a_phase, a_stride);
+}
+
+__attribute__((target("avx2,fma"), optimize("tree-vectorize")))
+static void decimate_lanes_avx2 (int a_lanes, int a_count, int a_sections, int a_taps, int a_low, double** a_weights,
+				 const double* a_alpha_re, const double* a_alpha_im, double** a_state_re, double** a_state_im,
+				 double* a_sums, const roj_complex* a_samples, int a_length, roj_complex*** a_outputs, int a_hop, int a_phase, int a_stride){
+
+  decimate_lanes(a_lanes, a_count, a_sections, a_taps, a_low, a_weights, a_alpha_re, a_alpha_im, a_state_re, a_state_im, a_sums, a_samples, a_length, a_outputs, a_hop, a_phase, a_stride);
+}
+#endif
+
+__attribute__((optimize("tree-vectorize")))
+static void decimate_lanes_generic (int a_lanes, int a_count, int a_sections, int a_taps, int a_low, double** a_weights,
+				    const double* a_alpha_re, const double* a_alpha_im, double** a_state_re, double** a_state_im,
+				    double* a_sums, const roj_complex* a_samples, int a_length, roj_complex*** a_outputs, int a_hop, int a_phase, int a_stride){
+
+  decimate_lanes(a_lanes, a_count, a_sections, a_taps, a_low, a_weights, a_alpha_re, a_alpha_im, a_state_re, a_state_im, a_sums, a_samples, a_length, a_outputs, a_hop, a_phase, a_stride);
+}
+
+/* ************************************************************************************************************************* */
+/**
+* @type: constructor
+* @brief: This is a constructor of roj_ode_decimator. Weights and poles are set by roj_filter_generator, states are zeroed.
+*
+* @param [in] a_order: A filter order of the highest tap (a number of sections).
+* @param [in] a_count: A number of channels.
+* @param [in] a_taps (default 1): A number of taps (filters of orders from a_order-a_taps+1 to a_order).
+*/
+roj_ode_decimator :: roj_ode_decimator (unsigned int a_order, int a_count, unsigned int a_taps){
+
+  if(a_order<1){
+    call_warning("in roj_ode_decimator :: roj_ode_decimator");
+    call_error("order < 1");
+  }
+
+  if(a_count<1){
+    call_warning("in roj_ode_decimator :: roj_ode_decimator");
+    call_error("number of channels < 1");
+  }
+
+  if(a_taps<1 or a_taps>a_order){
+    call_warning("in roj_ode_decimator :: roj_ode_decimator");
+    call_error("wrong number of taps");
+  }
+
+  m_order = a_order;
+  m_taps = a_taps;
+  m_count = a_count;
+
+  /* lanes are padded to the alignment */
+  int unit = ROJ_ALIGNMENT / sizeof(double);
+  m_lanes = (m_count + unit - 1) / unit * unit;
+
+  m_weights = new double* [m_taps];
+  for(int t=0; t<m_taps; t++){
+    m_weights[t] = new double [m_order];
+    memset(m_weights[t], 0x0, m_order * sizeof(double));
+  }
+
+  /* two rows of poles and 2*order rows of states */
+  int rows = 2 + 2*m_order;
+  size_t byte_size = (size_t)rows * m_lanes * sizeof(double);
+  if(posix_memalign(&m_memory, ROJ_ALIGNMENT, byte_size) != 0)
+    call_error("memory cannot be allocated");
+  memset(m_memory, 0x0, byte_size);
+
+  m_alpha_re = (double*)m_memory;
+  m_alpha_im = m_alpha_re + m_lanes;
+
+  m_state_re = new double* [m_order];
+  m_state_im = new double* [m_order];
+  for(int k=0; k<m_order; k++){
+    m_state_re[k] = m_alpha_re + (size_t)(2 + 2*k) * m_lanes;
+    m_state_im[k] = m_state_re[k] + m_lanes;
+  }
+}
+
+/**
+* @type: destructor
+* @brief: This is a destructor of roj_ode_decimator.
+*/
+roj_ode_decimator :: ~roj_ode_decimator (){
+
+  for(int t=0; t<m_taps; t++)
+    delete [] m_weights[t];
+  delete [] m_weights;
+
+  delete [] m_state_re;
+  delete [] m_state_im;
+  free(m_memory);
+}
+
+/* ************************************************************************************************************************* */
+/**
+* @type: method
+* @brief: This function returns the order of the highest tap.
+*
+* @return: A filter order.
+*/
+unsigned int roj_ode_decimator :: get_order (){
+
+  return m_order;
+}
+
+/**
+* @type: method
+* @brief: This function returns a number of taps.
+*
+* @return: A number of taps.
+*/
+unsigned int roj_ode_decimator :: get_taps (){
+
+  return m_taps;
+}
+
+/**
+* @type: method
+* @brief: This function returns a number of channels.
+*
+* @return: A number of channels.
+*/
+int roj_ode_decimator :: get_count (){
+
+  return m_count;
+}
+
+/* ************************************************************************************************************************* */
+/**
+* @type: method
+* @brief: This routine zeroes states of all sections.
+*/
+void roj_ode_decimator :: reset (){
+
+  for(int k=0; k<m_order; k++){
+    memset(m_state_re[k], 0x0, m_lanes * sizeof(double));
+    memset(m_state_im[k], 0x0, m_lanes * sizeof(double));
+  }
+}
+
+/**
+* @type: method
+* @brief: This routine filters the whole signal by consecutive channels and keeps each hop-th output sample of the highest tap, as roj_filter_bank :: filter_channel does. States are kept between calls. Disjoint ranges of channels can be processed concurrently.
+*
+* @param [in] a_first: An index of the first channel.
+* @param [in] a_count: A number of channels.
+* @param [in] a_sig: A signal for filtering.
+* @param [out] a_outputs: An array of output signals (one for each channel), which are created by this routine.
+* @param [in] a_hop (default 1): A hopsize.
+*/
+void roj_ode_decimator :: process (int a_first, int a_count, roj_complex_signal* a_sig, roj_complex_signal** a_outputs, int a_hop){
+
+  if(a_outputs == NULL){
+    call_warning("in roj_ode_decimator :: process");
+    call_error("arg is null");
+  }
+
+  roj_complex_signal*** outputs = new roj_complex_signal** [m_taps];
+  for(int t=0; t<m_taps; t++)
+    outputs[t] = NULL;
+  outputs[m_taps-1] = a_outputs;
+
+  process(a_first, a_count, a_sig, outputs, a_hop);
+  delete [] outputs;
+}
+
+/**
+* @type: method
+* @brief: This routine filters the whole signal by consecutive channels and keeps each hop-th output sample of requested taps. Disjoint ranges of channels can be processed concurrently.
+*
+* @param [in] a_first: An index of the first channel.
+* @param [in] a_count: A number of channels.
+* @param [in] a_sig: A signal for filtering.
+* @param [out] a_outputs: Arrays of output signals for each tap (one signal for each of a_count channels). Signals are created by this routine. Taps with NULL arrays are skipped.
+* @param [in] a_hop (default 1): A hopsize.
+*/
+void roj_ode_decimator :: process (int a_first, int a_count, roj_complex_signal* a_sig, roj_complex_signal*** a_outputs, int a_hop){
+
+  if(a_sig == NULL or a_outputs == NULL){
+    call_warning("in roj_ode_decimator :: process");
+    call_error("arg is null");
+  }
+
+  if(a_hop<1){
+    call_warning("in roj_ode_decimator :: process");
+    call_error("hop<1");
+  }
+
+  roj_signal_config in_conf = a_sig->get_config();
+  roj_signal_config out_conf;
+  out_conf.rate = in_conf.rate / a_hop;
+  out_conf.length = in_conf.length / a_hop;
+  out_conf.start = in_conf.start + (double)(a_hop-1) / in_conf.rate;
+
+  roj_complex*** waveforms = new roj_complex** [m_taps];
+  for(int t=0; t<m_taps; t++){
+    waveforms[t] = NULL;
+    if(a_outputs[t]!=NULL){
+      waveforms[t] = new roj_complex* [a_count];
+      for(int k=0; k<a_count; k++){
+	a_outputs[t][k] = new roj_complex_signal(out_conf);
+	waveforms[t][k] = a_outputs[t][k]->m_waveform;
+      }
+    }
+  }
+
+  process(a_first, a_count, a_sig->m_waveform, in_conf.length, waveforms, a_hop);
+
+  for(int t=0; t<m_taps; t++)
+    delete [] waveforms[t];
+  delete [] waveforms;
+}
+
+/**
+* @type: method
+* @brief: This routine filters a block of samples by consecutive channels and stores retained output samples of requested taps. Only sections up to the highest requested tap are advanced, so their states are not continued by later calls if higher taps are requested. The phase allows to continue the hop between blocks. Disjoint ranges of channels can be processed concurrently.
+*
+* @param [in] a_first: An index of the first channel.
+* @param [in] a_count: A number of channels.
+* @param [in] a_samples: Input samples.
+* @param [in] a_length: A number of input samples.
+* @param [out] a_outputs: Output waveforms for each tap (one for each of a_count channels, NULL for skipped taps). Retained sample n is stored at index (n+phase)/hop.
+* @param [in] a_hop (default 1): A hopsize.
+* @param [in] a_phase (default 0): A number of samples processed after the last retained sample (less than hop).
+*/
+void roj_ode_decimator :: process (int a_first, int a_count, const roj_complex* a_samples, int a_length, roj_complex*** a_outputs, int a_hop, int a_phase, int a_stride){
+
+  if(a_samples == NULL or a_outputs == NULL){
+    call_warning("in roj_ode_decimator :: process");
+    call_error("arg is null");
+  }
+
+  if(a_hop<1 or a_phase<0 or a_phase>=a_hop){
+    call_warning("in roj_ode_decimator :: process");
+    call_error("wrong hop or phase");
+  }
+
+  if(a_stride<1){
+    call_warning("in roj_ode_decimator :: process");
+    call_error("stride < 1");
+  }
+
+  if(a_count<1 or a_first<0 or a_first+a_count>m_count){
+    call_warning("in roj_ode_decimator :: process");
+    call_error("wrong index");
+  }
+
+  /* sections of the highest requested tap */
+  int sections = 0;
+  for(int t=0; t<m_taps; t++)
+    if(a_outputs[t]!=NULL)
+      sections = m_order - m_taps + 1 + t;
+
+  if(sections==0 or a_length<1)
+    return;
+
+  /* padding lanes are processed only with the last channel */
+  int lanes = a_count;
+  if(a_first+a_count == m_count)
+    lanes = m_lanes - a_first;
+
+  double** state_re = new double* [m_order];
+  double** state_im = new double* [m_order];
+  for(int k=0; k<m_order; k++){
+    state_re[k] = m_state_re[k] + a_first;
+    state_im[k] = m_state_im[k] + a_first;
+  }
+
+  double* sums = new double [2*lanes];
+
+#ifdef ROJ_KERNEL_DISPATCH
+  const char* isa = roj_filter_lanes :: get_isa();
+  if(strcmp(isa, "avx512")==0)
+    decimate_lanes_avx512(lanes, a_count, sections, m_taps, m_order - m_taps + 1, m_weights, m_alpha_re + a_first, m_alpha_im + a_first, state_re, state_im, sums, a_samples, a_length, a_outputs, a_hop, a_phase, a_stride);
+  else if(strcmp(isa, "avx2")==0)
+    decimate_lanes_avx2(lanes, a_count, sections, m_taps, m_order - m_taps + 1, m_weights, m_alpha_re + a_first, m_alpha_im + a_first, state_re, state_im, sums, a_samples, a_length, a_outputs, a_hop, a_phase, a_stride);
+  else
+#endif
+    decimate_lanes_generic(lanes, a_count, sections, m_taps, m_order - m_taps + 1, m_weights, m_alpha_re + a_first, m_alpha_im + a_first, state_re, state_im, sums, a_samples, a_length, a_outputs, a_hop, a_phase, a_stride);
+
+  delete [] state_re;
+  delete [] state_im;
+  delete [] sums;
+}
+
+/* ************************************************************************************************************************* */
+/**
+* @type: method
+* @brief: This routine returns taps required by distributions. Taps form a range around tap 2, which is the output of the analyzing filter: tap 1 is needed by derivative slots, tap 3 by ramp slots, tap 0 by the second derivative and tap 4 by the second ramp.
+*
+* @param [in] a_mask: A bitwise or of DIST_* codes.
+* @param [out] a_first: An index of the first required tap.
+* @param [out] a_last: An index of the last required tap.
+*/
+void roj_ode_decimator :: get_tap_range (int a_mask, int* a_first, int* a_last){
+
+  if(a_first==NULL or a_last==NULL){
+    call_warning("in roj_ode_decimator :: get_tap_range");
+    call_error("arg is null");
+  }
+
+  *a_first = 2;
+  if(a_mask & (DIST_IFREQ_1 | DIST_IFREQ_2 | DIST_CR_K | DIST_CR_D | DIST_CR_F | DIST_CR_M | DIST_DOF))
+    *a_first = 1;
+  if(a_mask & (DIST_CR_D | DIST_CR_M))
+    *a_first = 0;
+
+  *a_last = 2;
+  if(a_mask & (DIST_IFREQ_2 | DIST_DELAY | DIST_CR_K | DIST_CR_D | DIST_CR_F | DIST_CR_M | DIST_DOF))
+    *a_last = 3;
+  if(a_mask & (DIST_CR_F | DIST_CR_M))
+    *a_last = 4;
+}
+
+/**
+* @type: method
+* @brief: This routine derives slots of estimators from taps of a time instant. Derivative and ramp slots of ODE filters are defined with opposite signs than STFT slots, so yD and yT are negated and the same kernel formulas apply. A slot is calculated only if its taps are available.
+*
+* @param [in] a_taps: Five rows of taps (one sample for each channel, NULL if a tap is not calculated). Tap 2 is required.
+* @param [in] a_poles: Poles of channels.
+* @param [in] a_spread: A time spread of filters.
+* @param [in] a_order: An order of the analyzing filter.
+* @param [in] a_length: A number of channels.
+* @param [out] a_slots: Five rows for yD, yT, yDT, yD2 and yT2 slots.
+*
+* @return: Slots for roj_estimator_kernel :: calc (NULL for slots which are not available).
+*/
+roj_estimator_lines roj_ode_decimator :: get_estimator_lines (roj_complex** a_taps, complex double* a_poles, double a_spread, double a_order, int a_length, roj_complex** a_slots){
+
+  if(a_taps==NULL or a_taps[2]==NULL or a_poles==NULL or a_slots==NULL){
+    call_warning("in roj_ode_decimator :: get_estimator_lines");
+    call_error("arg is null");
+  }
+
+  roj_complex** w = a_taps;
+  double spread = a_spread;
+  double order = a_order;
+  
+  roj_estimator_lines lines;
+  lines.y = w[2];
+  lines.yD = NULL;
+  lines.yT = NULL;
+  lines.yDT = NULL;
+  lines.yD2 = NULL;
+  lines.yT2 = NULL;
+
+  if(w[1]){
+    lines.yD = a_slots[0];
+    for(int k=0; k<a_length; k++)
+      lines.yD[k] = -(w[1][k] / spread + w[2][k] * a_poles[k]);
+  }
+
+  if(w[3]){
+    lines.yT = a_slots[1];
+    for(int k=0; k<a_length; k++)
+      lines.yT[k] = -w[3][k] * spread * order;
+
+    lines.yDT = a_slots[2];
+    for(int k=0; k<a_length; k++)
+      lines.yDT[k] = w[2][k] * order + w[3][k] * order * spread * a_poles[k];
+  }
+
+  if(w[0] and w[1]){
+    lines.yD2 = a_slots[3];
+    for(int k=0; k<a_length; k++)
+      lines.yD2[k] = w[0][k] / (spread * spread) + 2.0 * a_poles[k] * w[1][k] / spread + a_poles[k] * a_poles[k] * w[2][k];
+  }
+
+  if(w[4]){
+    lines.yT2 = a_slots[4];
+    for(int k=0; k<a_length; k++)
+      lines.yT2[k] = order * (order + 1) * spread * spread * w[4][k];
+  }
+
+  return lines;
+}
@@ -0,0 +1,80 @@
+/* *************************************************** *
+ * This file is a part of ccROJ project (version 0-49) *
+ * distributed under GNU General Public License v3.0.  *
+ * Please visit the webpage: github.com/dsp-box/ccROJ  *
+ * for more information.                               *
+ *                       contact: Krzysztof Czarnecki  *
+ *                email: czarnecki.krzysiek@gmail.com  *
+ * *************************************************** */
+
+
+#ifndef _roj_ode_decim_
+#define _roj_ode_decim_
+
+/**
+* @type: class
+* @brief: Definition of roj_ode_decimator class. It is a decimating form of a bank of ODE filters. The transfer function B(z)/(1-alpha/z)^N is expanded into partial fractions, so each filter is a cascade of N identical one-pole sections and its output is a weighted sum of section states. Weights are real and the same for all filters of the bank. Filters of lower orders share the first sections of the cascade, so outputs of several orders (taps) are obtained by one recursion. Sections are advanced by one complex multiplication per sample, and outputs are calculated only for samples retained by the hop. States of channels are stored as split real and imaginary rows, so channels are lanes of SIMD registers. The instruction set is the same as of roj_filter_lanes (see roj_filter_lanes :: set_isa).
+*/
+
+/* ************************************************************************************************************************* */
+/* headers and declarations */
+
+#include "roj-external.hh"
+#include "roj-misc.hh"
+
+#include "roj-complex-signal.hh"
+class roj_complex_signal;
+
+#include "roj-filter-gener.hh"
+class roj_filter_generator;
+
+#include "roj-estim-kernel.hh"
+class roj_estimator_kernel;
+
+/* ************************************************************************************************************************* */
+/* decimator class definition */
+
+class roj_ode_decimator{
+  friend class roj_filter_generator;
+
+private:
+
+  /* configuration */
+  unsigned int m_order;
+  unsigned int m_taps;
+  int m_count;
+  int m_lanes;
+
+  /* partial fraction weights of taps (orders from order-taps+1 to order) */
+  double** m_weights;
+
+  /* poles and section states (rows of lanes) */
+  void* m_memory;
+  double* m_alpha_re;
+  double* m_alpha_im;
+  double** m_state_re;
+  double** m_state_im;
+
+public:
+
+  /* creation */
+  roj_ode_decimator(unsigned int, int, unsigned int =1);
+  ~roj_ode_decimator();
+
+  /* configuration */
+  unsigned int get_order();
+  unsigned int get_taps();
+  int get_count();
+
+  /* processing */
+  void reset();
+  void process(int, int, roj_complex_signal*, roj_complex_signal**, int =1);
+  void process(int, int, roj_complex_signal*, roj_complex_signal***, int =1);
+  void process(int, int, const roj_complex*, int, roj_complex***, int =1, int =0, int =1);
+
+  /* estimator slots of taps */
+  static void get_tap_range(int, int*, int*);
+  static roj_estimator_lines get_estimator_lines(roj_complex**, complex double*, double, double, int, roj_complex**);
+};
+
+#endif
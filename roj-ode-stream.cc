@@ -0,0 +1,289 @@
+/* *************************************************** *
+ * This file is a part of ccROJ project (version 0-49) *
+ * distributed under GNU General Public License v3.0.  *
+ * Please visit the webpage: github.com/dsp-box/ccROJ  *
+ * for more information.                               *
+ *                       contact: Krzysztof Czarnecki  *
+ *                email: czarnecki.krzysiek@gmail.com  *
+ * *************************************************** */
+
+
+#include "roj-ode-stream.hh"
+
+/* ************************************************************************************************************************* */
+/**
+* @type: constructor
+* @brief: This is a constructor of roj_ode_stream.
+*
+* @param [in] a_bank_conf: A bank configuration (frequency axis).
+* @param [in] a_filter_gen: A pointer to a filter generator (order N of the main bank, order N-2 has to be positive).
+* @param [in] a_hop (default 1): A hopsize.
+* @param [in] a_start (default 0.0): Time of the first sample.
+*/
+roj_ode_stream :: roj_ode_stream (roj_array_config a_bank_conf, roj_filter_generator* a_filter_gen, int a_hop, double a_start){
+
+  if(a_filter_gen==NULL){
+    call_warning("in roj_ode_stream :: roj_ode_stream");
+    call_error("arg is null");
+  }
+
+  if(a_hop<1){
+    call_warning("in roj_ode_stream :: roj_ode_stream");
+    call_error("hop < 1");
+  }
+
+  if(a_bank_conf.length<1){
+    call_warning("in roj_ode_stream :: roj_ode_stream");
+    call_error("filter number is negative or zero");
+  }
+
+  if(a_bank_conf.min>=a_bank_conf.max and a_bank_conf.length>1){
+    call_warning("in roj_ode_stream :: roj_ode_stream");
+    call_error("init frequency is grater than final");
+  }
+
+  if(a_filter_gen->get_order()<3){
+    call_warning("in roj_ode_stream :: roj_ode_stream");
+    call_error("order < 3");
+  }
+
+  if(a_filter_gen->get_delay()!=1){
+    call_warning("in roj_ode_stream :: roj_ode_stream");
+    call_error("stream requires filters without output delay");
+  }
+
+  m_bank_config = a_bank_conf;
+  m_rate = a_filter_gen->get_rate();
+  m_spread = a_filter_gen->get_spread();
+  m_order = a_filter_gen->get_order();
+  m_hop = a_hop;
+  m_mask = DIST_ENERGY;
+  m_sink = NULL;
+
+  /* taps of orders from N-2 to N+2 */
+  roj_filter_generator filter_gen(*a_filter_gen);
+  filter_gen.set_type(ROJ_ODE_FILTER);
+  filter_gen.set_order(a_filter_gen->get_order() + 2);
+  m_cascade = filter_gen.get_ode_decimator(m_bank_config, 5);
+
+  int height = m_bank_config.length;
+  double delta = (m_bank_config.max - m_bank_config.min) / (height-1);
+  if (height == 1)
+    delta = 0.0;
+
+  m_poles = new complex double [height];
+  for(int k=0; k<height; k++)
+    m_poles[k] = I*TWO_PI * (m_bank_config.min + k * delta) -1.0/m_spread;
+
+  m_kernel = new roj_estimator_kernel(height);
+  m_slots = allocate_complex_rows(5, height);
+  m_estimates = allocate_real_rows(9, height);
+
+  m_buffer = NULL;
+  m_waveforms = new roj_complex** [5];
+  for(int o=0; o<5; o++)
+    m_waveforms[o] = new roj_complex* [height];
+
+  m_phase = 0;
+  m_samples = 0;
+  m_columns = 0;
+  m_start = a_start;
+
+  set_block_size();
+}
+
+/**
+* @type: destructor
+* @brief: This is a stream destructor.
+*/
+roj_ode_stream :: ~roj_ode_stream (){
+
+  for(int o=0; o<5; o++)
+    delete [] m_waveforms[o];
+  delete [] m_waveforms;
+
+  release_rows(m_buffer);
+  release_rows(m_slots);
+  release_rows(m_estimates);
+
+  delete m_kernel;
+  delete m_cascade;
+  delete [] m_poles;
+}
+
+/* ************************************************************************************************************************* */
+/**
+* @type: method
+* @brief: This function sets a sink, which receives finished columns.
+*
+* @param [in] a_sink: A pointer to a sink (it is not released by the stream).
+*/
+void roj_ode_stream :: set_sink (roj_column_sink* a_sink){
+
+  m_sink = a_sink;
+}
+
+/**
+* @type: method
+* @brief: This function sets distributions passed to the sink. It can be changed only before the first sample is written, because only sections of required taps are advanced.
+*
+* @param [in] a_mask (default DIST_ENERGY): A bitwise or of DIST_* codes.
+*/
+void roj_ode_stream :: set_mask (int a_mask){
+
+  if(a_mask==0){
+    call_warning("in roj_ode_stream :: set_mask");
+    call_error("no distribution is requested");
+  }
+
+  if(m_samples>0){
+    call_warning("in roj_ode_stream :: set_mask");
+    call_error("stream is already started");
+  }
+
+  m_mask = a_mask;
+}
+
+/**
+* @type: method
+* @brief: This function sets a maximal number of columns, whose taps are calculated by one pass of the cascade.
+*
+* @param [in] a_block_size (default ROJ_STREAM_BLOCK): A number of columns (at least 1).
+*/
+void roj_ode_stream :: set_block_size (unsigned int a_block_size){
+
+  if(a_block_size<1){
+    call_warning("in roj_ode_stream :: set_block_size");
+    call_error("block size < 1");
+  }
+
+  m_block_size = a_block_size;
+
+  /* each column of each tap has its own row of channels */
+  int height = m_bank_config.length;
+  release_rows(m_buffer);
+  m_buffer = allocate_complex_rows(5 * m_block_size, height);
+  m_stride = m_buffer[1] - m_buffer[0];
+
+  for(int o=0; o<5; o++)
+    for(int k=0; k<height; k++)
+      m_waveforms[o][k] = &m_buffer[o * m_block_size][k];
+}
+
+/* ************************************************************************************************************************* */
+/**
+* @type: method
+* @brief: This function appends samples to the stream. Columns are passed to the sink as soon as their samples are filtered.
+*
+* @param [in] a_samples: A pointer to samples.
+* @param [in] a_count: A number of samples.
+*/
+void roj_ode_stream :: write (roj_complex* a_samples, unsigned int a_count){
+
+  if(a_samples==NULL and a_count>0){
+    call_warning("in roj_ode_stream :: write");
+    call_error("arg is null");
+  }
+
+  if(m_sink==NULL){
+    call_warning("in roj_ode_stream :: write");
+    call_error("sink is not set");
+  }
+
+  /* required taps (they form a range around tap 2) */
+  int first, last;
+  roj_ode_decimator :: get_tap_range(m_mask, &first, &last);
+
+  roj_complex** taps[5];
+  for(int o=0; o<5; o++)
+    taps[o] = o>=first and o<=last ? m_waveforms[o] : NULL;
+
+  while(a_count>0){
+
+    unsigned int count = m_block_size * m_hop - m_phase;
+    if(count > a_count)
+      count = a_count;
+
+    m_cascade->process(0, m_bank_config.length, a_samples, count, taps, m_hop, m_phase, m_stride);
+
+    /* the first column of the block is at sample hop-1-phase */
+    unsigned int columns = (m_phase + count) / m_hop;
+    for(unsigned int n=0; n<columns; n++){
+      unsigned long position = m_samples + n * m_hop + m_hop - 1 - m_phase;
+      estimating(taps, n, m_start + position / m_rate);
+    }
+
+    m_phase = (m_phase + count) % m_hop;
+    m_samples += count;
+    a_samples += count;
+    a_count -= count;
+  }
+}
+
+/**
+* @type: method
+* @brief: This function appends samples of a signal to the stream.
+*
+* @param [in] a_signal: A pointer to a signal (its sampling rate has to be equal to the filter rate).
+*/
+void roj_ode_stream :: write (roj_complex_signal* a_signal){
+
+  if(a_signal==NULL){
+    call_warning("in roj_ode_stream :: write");
+    call_error("arg is null");
+  }
+
+  roj_signal_config conf = a_signal->get_config();
+  if(conf.rate!=m_rate){
+    call_warning("in roj_ode_stream :: write");
+    call_error("signal and filter sampling rates are different");
+  }
+
+  write(a_signal->m_waveform, conf.length);
+}
+
+/**
+* @type: method
+* @brief: This function returns a number of columns passed to the sink.
+*
+* @return: A number of columns.
+*/
+unsigned long roj_ode_stream :: get_columns (){
+
+  return m_columns;
+}
+
+/* ************************************************************************************************************************* */
+/**
+* @type: private
+* @brief: This function calculates distributions of a column from taps and passes them to the sink. Slots are derived from taps by roj_ode_decimator :: get_estimator_lines, as in roj_ode_analyzer.
+*
+* @param [in] a_taps: Waveforms of taps (NULL if a tap is not calculated).
+* @param [in] a_column: An index of the column in the current block.
+* @param [in] a_time: Time of the column.
+*/
+void roj_ode_stream :: estimating (roj_complex*** a_taps, unsigned int a_column, double a_time){
+
+  int height = m_bank_config.length;
+  
+  roj_estimator_maps maps;
+  maps.energy = m_mask & DIST_ENERGY ? m_estimates[8] : NULL;
+  maps.ifreq_1 = m_mask & DIST_IFREQ_1 ? m_estimates[0] : NULL;
+  maps.ifreq_2 = m_mask & DIST_IFREQ_2 ? m_estimates[1] : NULL;
+  maps.delay = m_mask & DIST_DELAY ? m_estimates[2] : NULL;
+  maps.k_rate = m_mask & DIST_CR_K ? m_estimates[3] : NULL;
+  maps.m_rate = m_mask & DIST_CR_M ? m_estimates[4] : NULL;
+  maps.d_rate = m_mask & DIST_CR_D ? m_estimates[5] : NULL;
+  maps.f_rate = m_mask & DIST_CR_F ? m_estimates[6] : NULL;
+  maps.dof = m_mask & DIST_DOF ? m_estimates[7] : NULL;
+
+  /* rows of taps of the column */
+  roj_complex* w[5];
+  for(int o=0; o<5; o++)
+    w[o] = a_taps[o]!=NULL ? m_buffer[o * m_block_size + a_column] : NULL;
+
+  roj_estimator_lines lines = roj_ode_decimator :: get_estimator_lines(w, m_poles, m_spread, m_order, height, m_slots);
+  m_kernel->calc(lines, maps);
+  m_sink->write_column(a_time, m_bank_config, maps);
+  m_columns++;
+}
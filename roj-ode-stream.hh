@@ -0,0 +1,92 @@
+/* *************************************************** *
+ * This file is a part of ccROJ project (version 0-49) *
+ * distributed under GNU General Public License v3.0.  *
+ * Please visit the webpage: github.com/dsp-box/ccROJ  *
+ * for more information.                               *
+ *                       contact: Krzysztof Czarnecki  *
+ *                email: czarnecki.krzysiek@gmail.com  *
+ * *************************************************** */
+
+
+#ifndef _roj_ode_stream_
+#define _roj_ode_stream_
+
+/**
+* @type: class
+* @brief: Definition of roj_ode_stream class. A stream accepts blocks of samples of any length and keeps only states of the shared-pole cascade of ODE filters (see roj_ode_decimator). Each hop-th sample gives a column of requested distributions, which is passed to a sink (see roj_column_sink) at once, so memory does not depend on the signal length.
+*/
+
+/* ************************************************************************************************************************* */
+/* headers and declarations */
+
+#include "roj-external.hh"
+#include "roj-misc.hh"
+
+#include "roj-filter-gener.hh"
+class roj_filter_generator;
+
+#include "roj-ode-decim.hh"
+class roj_ode_decimator;
+
+#include "roj-estim-kernel.hh"
+class roj_estimator_kernel;
+
+#include "roj-stft-stream.hh"
+class roj_column_sink;
+
+/* ************************************************************************************************************************* */
+/* stream class definition */
+
+class roj_ode_stream{
+private:
+
+  /* cascade with taps of orders from N-2 to N+2 */
+  roj_ode_decimator* m_cascade;
+  roj_column_sink* m_sink;
+
+  /* configuration */
+  roj_array_config m_bank_config;
+  complex double* m_poles;
+  double m_rate;
+  double m_spread;
+  double m_order;
+  int m_hop;
+  int m_mask;
+  unsigned int m_block_size;
+
+  /* taps of columns of the current block */
+  roj_complex** m_buffer;
+  roj_complex*** m_waveforms;
+  int m_stride;
+
+  /* column buffers */
+  roj_estimator_kernel* m_kernel;
+  roj_complex** m_slots;
+  roj_real** m_estimates;
+
+  /* position in the stream */
+  unsigned int m_phase;
+  unsigned long m_samples;
+  unsigned long m_columns;
+  double m_start;
+
+  void estimating(roj_complex***, unsigned int, double);
+  
+public:
+
+  /* construction */
+  roj_ode_stream(roj_array_config, roj_filter_generator*, int =1, double =0.0);
+  ~roj_ode_stream();
+
+  /* configuration */
+  void set_sink(roj_column_sink*);
+  void set_mask(int =DIST_ENERGY);
+  void set_block_size(unsigned int =ROJ_STREAM_BLOCK);
+
+  /* streaming */
+  void write(roj_complex*, unsigned int);
+  void write(roj_complex_signal*);
+  unsigned long get_columns();
+};
+
+#endif
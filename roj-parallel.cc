@@ -0,0 +1,154 @@
+/* *************************************************** *
+ * This file is a part of ccROJ project (version 0-49) *
+ * distributed under GNU General Public License v3.0.  *
+ * Please visit the webpage: github.com/dsp-box/ccROJ  *
+ * for more information.                               *
+ *                       contact: Krzysztof Czarnecki  *
+ *                email: czarnecki.krzysiek@gmail.com  *
+ * *************************************************** */
+
+#include "roj-parallel.hh"
+
+/* ************************************************************************************************************************* */
+/* structure definitions */
+
+/**
+* @type: struct
+* @brief: This is an argument of a worker thread.
+*/
+struct roj_worker_arg{
+
+  roj_parallel_job* job;
+  int index;
+};
+
+/* ************************************************************************************************************************* */
+/**
+* @type: constructor
+* @brief: This is a constructor of roj_parallel_job.
+*/
+roj_parallel_job :: roj_parallel_job (){
+
+  m_next_item = 0;
+  m_done_items = 0;
+  m_items = 0;
+}
+
+/**
+* @type: destructor
+* @brief: This is a destructor of roj_parallel_job.
+*/
+roj_parallel_job :: ~roj_parallel_job (){
+}
+
+/* ************************************************************************************************************************* */
+/**
+* @type: method
+* @brief: This routine processes all items of the job. Items are taken by workers one by one, so the load is balanced dynamically.
+*
+* @param [in] a_items: A number of items.
+* @param [in] a_threads (default 1): A number of worker threads. If it is 1, the job is processed by the calling thread.
+*/
+void roj_parallel_job :: run (int a_items, unsigned int a_threads){
+
+  if(a_threads<1){
+    call_warning("in roj_parallel_job :: run");
+    call_error("number of threads < 1");
+  }
+
+  m_next_item = 0;
+  m_done_items = 0;
+  m_items = a_items;
+
+  if(a_threads > a_items)
+    a_threads = a_items;
+  
+  if(a_threads < 2){
+    work(0);
+    return;
+  }
+
+  pthread_t* threads = new pthread_t[a_threads];
+  roj_worker_arg* args = new roj_worker_arg[a_threads];
+
+  for(int w=0; w<a_threads; w++){
+    args[w].job = this;
+    args[w].index = w;
+    if(pthread_create(&threads[w], NULL, worker, &args[w]) != 0){
+      call_warning("in roj_parallel_job :: run");
+      call_error("thread cannot be created");
+    }
+  }
+
+  for(int w=0; w<a_threads; w++)
+    pthread_join(threads[w], NULL);
+
+  delete [] args;
+  delete [] threads;
+}
+
+/**
+* @type: private
+* @brief: This is a thread routine.
+*
+* @param [in] a_arg: A pointer to roj_worker_arg structure.
+*
+* @return: NULL.
+*/
+void* roj_parallel_job :: worker (void* a_arg){
+
+  roj_worker_arg* arg = (roj_worker_arg*)a_arg;
+  arg->job->work(arg->index);
+  return NULL;
+}
+
+/**
+* @type: private
+* @brief: This routine takes items until all of them are processed.
+*
+* @param [in] a_worker: An index of the worker.
+*/
+void roj_parallel_job :: work (int a_worker){
+
+  begin(a_worker);
+
+  int item = __sync_fetch_and_add(&m_next_item, 1);
+  while(item < m_items){
+    execute(item, a_worker);
+    item = __sync_fetch_and_add(&m_next_item, 1);
+  }
+  
+  end(a_worker);
+}
+
+/* ************************************************************************************************************************* */
+/**
+* @type: method
+* @brief: This routine is called by each worker before processing of items. It can be used for allocation of worker buffers.
+*
+* @param [in] a_worker: An index of the worker.
+*/
+void roj_parallel_job :: begin (int a_worker){
+}
+
+/**
+* @type: method
+* @brief: This routine is called by each worker after processing of items.
+*
+* @param [in] a_worker: An index of the worker.
+*/
+void roj_parallel_job :: end (int a_worker){
+}
+
+/**
+* @type: method
+* @brief: This routine atomically increases the counter of processed units. It is used for progress printing.
+*
+* @param [in] a_count: A number of processed units.
+*
+* @return: The total number of processed units.
+*/
+int roj_parallel_job :: finish_items (int a_count){
+
+  return __sync_add_and_fetch(&m_done_items, a_count);
+}
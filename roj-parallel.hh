@@ -0,0 +1,60 @@
+/* *************************************************** *
+ * This file is a part of ccROJ project (version 0-49) *
+ * distributed under GNU General Public License v3.0.  *
+ * Please visit the webpage: github.com/dsp-box/ccROJ  *
+ * for more information.                               *
+ *                       contact: Krzysztof Czarnecki  *
+ *                email: czarnecki.krzysiek@gmail.com  *
+ * *************************************************** */
+
+#ifndef _roj_parallel_
+#define _roj_parallel_
+
+/**
+* @type: class
+* @brief: Definition of roj_parallel_job abstract class. A job consists of independent items, which are distributed dynamically between worker threads.
+*/
+
+/* ************************************************************************************************************************* */
+/* headers and declarations */
+
+#include "roj-external.hh"
+#include "roj-misc.hh"
+
+/* ************************************************************************************************************************* */
+/* parallel job class definition */
+
+class roj_parallel_job{
+private:
+
+  /* shared counters (modified atomically) */
+  volatile int m_next_item;
+  volatile int m_done_items;
+  int m_items;
+
+  /* thread routine */
+  static void* worker(void*);
+  void work(int);
+  
+protected:
+
+  /* worker setup and cleanup */
+  virtual void begin(int);
+  virtual void end(int);
+
+  /* processing of one item */
+  virtual void execute(int, int) =0;
+
+  /* progress counter */
+  int finish_items(int);
+  
+public:
+
+  /* construction */
+  roj_parallel_job();
+  virtual ~roj_parallel_job();
+
+  void run(int, unsigned int =1);
+};
+
+#endif
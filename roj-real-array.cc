@@ -23,8 +23,8 @@ roj_real_array :: roj_real_array (roj_array_config a_conf){
   m_config = a_conf;
   
   /* allocate memory for samples */
-  m_data = new double [m_config.length];
-  int byte_size = m_config.length * sizeof(double);
+  m_data = new roj_real[m_config.length];
+  int byte_size = m_config.length * sizeof(roj_real);
   memset(m_data, 0x0, byte_size);
 
   /* usable in some cases*/
@@ -47,8 +47,8 @@ roj_real_array :: roj_real_array (roj_real_array* a_arr){
   m_config = a_arr->get_config();
   
   /* allocate memory for samples */
-  m_data = new double [m_config.length];
-  int byte_size = m_config.length * sizeof(double);
+  m_data = new roj_real[m_config.length];
+  int byte_size = m_config.length * sizeof(roj_real);
   memcpy(m_data, a_arr->m_data, byte_size);
 
   m_counter = a_arr->return_counter();
@@ -112,8 +112,8 @@ roj_real_array :: roj_real_array (char* a_fname){
   verify_config(m_config);
 
   /* allocate memory for samples */
-  m_data = new double [m_config.length];
-  int byte_size = m_config.length * sizeof(double);
+  m_data = new roj_real[m_config.length];
+  int byte_size = m_config.length * sizeof(roj_real);
   memset(m_data, 0x0, byte_size);
 
   f_ptr = fopen(a_fname, "r");
@@ -178,7 +178,7 @@ int roj_real_array :: return_counter (){
 */
 void roj_real_array :: clear (){
 
-  int byte_size = m_config.length * sizeof(double);
+  int byte_size = m_config.length * sizeof(roj_real);
   memset(m_data, 0x0, byte_size);
 }
 
@@ -233,8 +233,8 @@ roj_array_config roj_real_array :: cut_head(int a_head){
   m_config.length -= a_head;
   m_config.min += a_head * d;
 
-  double *new_data = new double[m_config.length];
-  memcpy(new_data, &m_data[a_head], m_config.length*sizeof(double));
+  roj_real *new_data = new roj_real[m_config.length];
+  memcpy(new_data, &m_data[a_head], m_config.length*sizeof(roj_real));
   delete [] m_data;
   m_data = new_data;
 
@@ -260,8 +260,8 @@ roj_array_config roj_real_array :: cut_tail(int a_tail){
   m_config.length -= a_tail;
   m_config.max -= a_tail * d;
 
-  double *new_data = new double[m_config.length];
-  memcpy(new_data, m_data, m_config.length*sizeof(double));
+  roj_real *new_data = new roj_real[m_config.length];
+  memcpy(new_data, m_data, m_config.length*sizeof(roj_real));
   delete [] m_data;
   m_data = new_data;
 
@@ -76,7 +76,7 @@ public:
    * @type: field
    * @brief: This public pointer gives access to array elements.
    */
-  double* m_data;
+  roj_real* m_data;
 
   /* operators */
   void operator /= (double);
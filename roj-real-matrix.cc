@@ -27,13 +27,8 @@ roj_real_matrix :: roj_real_matrix (roj_image_config a_conf){
     call_error("matrix configuration is failed");
   }
 
-  /* allocate memory for data */
-  m_data = new double*[m_config.x.length];
-  int byte_size = m_config.y.length * sizeof(double);
-  for(int n=0; n<m_config.x.length; n++){
-    m_data[n] = new double[m_config.y.length];    
-    memset(m_data[n], 0x0, byte_size);
-  }
+  /* allocate memory for data (one contiguous buffer) */
+  m_data = allocate_real_rows(m_config.x.length, m_config.y.length);
 }
 
 /**
@@ -60,13 +55,11 @@ roj_real_matrix :: roj_real_matrix (roj_real_matrix* a_matrix){
   roj_image_config conf = a_matrix->get_config();
   m_config = conf;
   
-  /* allocate memory for data */
-  m_data = new double*[m_config.x.length];
-  int byte_size = m_config.y.length * sizeof(double);
-  for(int n=0; n<m_config.x.length; n++){
-    m_data[n] = new double[m_config.y.length];    
+  /* allocate memory for data (one contiguous buffer) */
+  m_data = allocate_real_rows(m_config.x.length, m_config.y.length);
+  int byte_size = m_config.y.length * sizeof(roj_real);
+  for(int n=0; n<m_config.x.length; n++)
     memcpy(m_data[n], a_matrix->m_data[n], byte_size);
-  }
 }
 
 /**
@@ -75,9 +68,7 @@ roj_real_matrix :: roj_real_matrix (roj_real_matrix* a_matrix){
  */
 roj_real_matrix :: ~roj_real_matrix (){  
 
-  for(int n=0;n<m_config.x.length;n++)
-    delete [] m_data[n];    
-  delete [] m_data;
+  release_rows(m_data);
 }
 
 /* ************************************************************************************************************************* */
@@ -86,10 +77,11 @@ roj_real_matrix :: ~roj_real_matrix (){
  * @brief: This routine cleans data.
  */
 void roj_real_matrix :: clear (){
-  
-  int byte_size = m_config.y.length * sizeof(double);
-  for(int n=0; n<m_config.x.length; n++)
-    memset(m_data[n], 0x0, byte_size);
+
+  /* rows are padded as in allocate_real_rows and stored in one block */
+  int unit = ROJ_ALIGNMENT / sizeof(roj_real);
+  int stride = (m_config.y.length + unit - 1) / unit * unit;
+  memset(m_data[0], 0x0, (size_t)m_config.x.length * stride * sizeof(roj_real));
 }
 
 
@@ -110,7 +102,7 @@ void roj_real_matrix :: abs (){
 /* ************************************************************************************************************************* */
 /**
  * @type: method
- * @brief: This routine replaces NaN values with 1E300. 
+ * @brief: This routine replaces NaN and infinite values with ROJ_NO_ESTIMATE. 
  */
 void roj_real_matrix :: remove_nan (){
 
@@ -118,9 +110,9 @@ void roj_real_matrix :: remove_nan (){
     for(int k=0; k<m_config.y.length; k++){
       
       if(isnan(m_data[n][k]))
-	m_data[n][k] = 1E300;
+	m_data[n][k] = ROJ_NO_ESTIMATE;
       if(isinf(m_data[n][k]))
-	m_data[n][k] = 1E300;
+	m_data[n][k] = ROJ_NO_ESTIMATE;
     }
 }
 
@@ -632,7 +624,7 @@ roj_real_matrix* roj_real_matrix :: cropping (roj_image_config a_conf){
   img_conf.y.max = m_config.y.min + max_findex * felta;
 
   roj_real_matrix* out_matrix = new roj_real_matrix(img_conf);
-  int byte_size = new_height * sizeof(double); 
+  int byte_size = new_height * sizeof(roj_real); 
   for(int n=0; n<new_width; n++)
     memcpy(out_matrix->m_data[n], &m_data[n+min_tindex][min_findex], byte_size);
 
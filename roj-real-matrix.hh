@@ -44,7 +44,7 @@ public:
    * @type: field
    * @brief: This public pointer gives access to xy data.
    */
-  double **m_data;
+  roj_real **m_data;
 
   /* save to text file */
   void save(char*);
@@ -0,0 +1,704 @@
+/* *************************************************** *
+ * This file is a part of ccROJ project (version 0-49) *
+ * distributed under GNU General Public License v3.0.  *
+ * Please visit the webpage: github.com/dsp-box/ccROJ  *
+ * for more information.                               *
+ *                       contact: Krzysztof Czarnecki  *
+ *                email: czarnecki.krzysiek@gmail.com  *
+ * *************************************************** */
+
+#include "roj-stft-job.hh"
+#include "roj-xxt-analyzer.hh"
+
+/* ************************************************************************************************************************* */
+/**
+* @type: constructor
+* @brief: This is a constructor of roj_stft_job. For the pruned engine, the analyzed band is demodulated to zero frequency and the FFT of the bank length is split into short transforms of decimated frames, which are combined only for required lines. For the sliding engine, each window is expressed as a sum of complex exponentials, so each line is a combination of rectangular sliding DFTs.
+*
+* @param [in] a_analyzer: A pointer to the analyzer.
+* @param [in] a_codes: Codes of calculated slots.
+* @param [out] a_stft: Allocated STFT buffers (one for each slot).
+* @param [in] a_batch: A number of frames in one item.
+* @param [in] a_real: If true, frames are real and r2c transforms are used.
+* @param [in] a_engine (default ROJ_FFT_ENGINE): ROJ_FFT_ENGINE, ROJ_PRUNED_ENGINE or ROJ_SLIDING_ENGINE.
+*/
+roj_stft_job :: roj_stft_job (roj_xxt_analyzer* a_analyzer, std::vector<std::pair<int, int> > a_codes, roj_complex*** a_stft, int a_batch, bool a_real, int a_engine){
+
+  if(a_engine!=ROJ_FFT_ENGINE and a_engine!=ROJ_PRUNED_ENGINE and a_engine!=ROJ_SLIDING_ENGINE){
+    call_warning("in roj_stft_job :: roj_stft_job");
+    call_error("unknown engine");
+  }
+  
+  m_analyzer = a_analyzer;
+  m_codes = a_codes;
+  m_stft = a_stft;
+  m_batch = a_batch;
+  m_engine = a_engine;
+  m_real = a_real and a_engine==ROJ_FFT_ENGINE;
+
+  m_positions = NULL;
+  m_demodulation = NULL;
+  m_twiddles = NULL;
+
+  m_rotations = NULL;
+  m_tails = NULL;
+  m_coefs = NULL;
+
+  /* windows of all bins are kept together */
+  m_bins = m_analyzer->get_chirp_bins();
+  m_cache_limit = ROJ_WINDOW_CACHE;
+  if(m_bins!=NULL and m_bins->count > m_cache_limit)
+    m_cache_limit = m_bins->count;
+
+  if(m_bins!=NULL and (m_engine==ROJ_SLIDING_ENGINE or m_real)){
+    call_warning("in roj_stft_job :: roj_stft_job");
+    call_error("chirp-rate bins require the fft or pruned engine");
+  }
+  
+  if(m_engine==ROJ_PRUNED_ENGINE){
+
+    int length = m_analyzer->m_bank_config.length;
+    int height = m_analyzer->get_height();
+    int win_length = m_analyzer->m_window_gen->get_length();
+    int start_index = (length-win_length) / 2;
+    int first = (m_analyzer->get_initial() + (length+1)/2) % length;
+    
+    m_prune = calc_prune_length(length, height);
+    m_phases = length / m_prune;
+
+    /* sample q is stored in short transform q%phases at position q/phases */
+    m_positions = new int[win_length];
+    m_demodulation = new complex double[win_length];
+    for(int m=0; m<win_length; m++){
+      long q = start_index + m;
+      m_positions[m] = (q % m_phases) * m_prune + q / m_phases;
+      m_demodulation[m] = cexp(-1I * TWO_PI * (double)((first * q) % length) / length);
+    }
+
+    m_twiddles = new complex double[height * m_phases];
+    for(long k=0; k<height; k++)
+      for(long p=0; p<m_phases; p++)
+	m_twiddles[k*m_phases+p] = cexp(-1I * TWO_PI * (double)((k * p) % length) / length);
+  }
+  
+  if(m_engine==ROJ_SLIDING_ENGINE){
+
+    int slots = m_codes.size();
+    int order = ROJ_COSINE_ORDER;
+    int length = m_analyzer->m_bank_config.length;
+    int height = m_analyzer->get_height();
+    int win_length = m_analyzer->m_window_gen->get_length();
+    int start_index = (length-win_length) / 2;
+    int first = (m_analyzer->get_initial() + (length+1)/2) % length;
+
+    /* window coefficients of each slot */
+    complex double* win_coefs = new complex double[slots * (2*order+1)];
+    for(int s=0; s<slots; s++){
+      roj_complex_signal* window = m_analyzer->m_window_gen->get_window(m_codes[s].first, m_codes[s].second);
+      if(!calc_cosine_coefs(window, &win_coefs[s*(2*order+1)])){
+	call_warning("in roj_stft_job :: roj_stft_job");
+	call_error("window is not a cosine sum");
+      }
+      delete window;
+    }
+
+    /* only frequencies used by some window are tracked */
+    int* terms = new int[2*order+1];
+    m_terms = 0;
+    for(int i=-order; i<=order; i++)
+      for(int s=0; s<slots; s++)
+	if(win_coefs[s*(2*order+1)+i+order] != 0.0){
+	  terms[m_terms++] = i;
+	  break;
+	}
+    
+    m_rotations = new complex double[height * m_terms];
+    m_tails = new complex double[height * m_terms];
+    m_coefs = new complex double*[slots];
+    for(int s=0; s<slots; s++)
+      m_coefs[s] = new complex double[height * m_terms];
+    
+    for(long k=0; k<height; k++){
+      long line = (first + k) % length;
+      complex double phase = cexp(-1I * TWO_PI * (double)((line * start_index) % length) / length);
+
+      for(int t=0; t<m_terms; t++){
+	double freq = (double)line / length - (double)terms[t] / win_length;
+	m_rotations[k*m_terms+t] = cexp(1I * TWO_PI * freq);
+	m_tails[k*m_terms+t] = cexp(-1I * TWO_PI * freq * win_length);
+	for(int s=0; s<slots; s++)
+	  m_coefs[s][k*m_terms+t] = phase * win_coefs[s*(2*order+1)+terms[t]+order];
+      }
+    }
+    
+    delete [] terms;
+    delete [] win_coefs;
+  }
+  
+  int threads = m_analyzer->m_threads;
+  m_trackers = new complex double*[threads];
+  m_window_gens = new roj_window_generator*[threads];
+  m_windows = new roj_complex**[threads];
+  m_window_caches = new std::map<double, roj_complex**>[threads];
+  m_in_buffers = new roj_complex*[threads];
+  m_out_buffers = new roj_complex*[threads];
+}
+
+/**
+* @type: destructor
+* @brief: This is a destructor of roj_stft_job.
+*/
+roj_stft_job :: ~roj_stft_job (){
+
+  delete [] m_out_buffers;
+  delete [] m_in_buffers;
+  delete [] m_window_caches;
+  delete [] m_windows;
+  delete [] m_window_gens;
+  delete [] m_trackers;
+
+  if(m_coefs != NULL)
+    for(int s=0; s<m_codes.size(); s++)
+      delete [] m_coefs[s];
+  delete [] m_coefs;
+  delete [] m_tails;
+  delete [] m_rotations;
+
+  delete [] m_twiddles;
+  delete [] m_demodulation;
+  delete [] m_positions;
+}
+
+/* ************************************************************************************************************************* */
+/**
+* @type: method
+* @brief: This function restricts the job to given STFT columns, so only columns of slots which are not valid anymore are calculated again. Items are batches of the listed columns. It cannot be used by the sliding engine, which needs consecutive columns.
+*
+* @param [in] a_columns: Indexes of calculated columns (all columns if empty).
+*/
+void roj_stft_job :: set_columns (std::vector<int> a_columns){
+
+  if(!a_columns.empty() and m_engine==ROJ_SLIDING_ENGINE){
+    call_warning("in roj_stft_job :: set_columns");
+    call_error("sliding engine requires all columns");
+  }
+
+  m_columns = a_columns;
+}
+
+/**
+* @type: private
+* @brief: This function returns an index of a calculated STFT column.
+*
+* @param [in] a_index: A position in the job.
+*
+* @return: An index of the column.
+*/
+int roj_stft_job :: get_column (int a_index){
+
+  if(m_columns.empty())
+    return a_index;
+  return m_columns[a_index];
+}
+
+/**
+* @type: private
+* @brief: This function returns a number of calculated STFT columns.
+*
+* @return: A number of columns.
+*/
+int roj_stft_job :: get_count (){
+
+  if(m_columns.empty())
+    return m_analyzer->get_width();
+  return m_columns.size();
+}
+
+/* ************************************************************************************************************************* */
+/**
+* @type: method
+* @brief: This function returns the length of short transforms of the pruned FFT. It is the smallest divisor of the bank length which is not less than the number of required lines.
+*
+* @param [in] a_length: A bank length.
+* @param [in] a_height: A number of required lines.
+*
+* @return: The length of short transforms.
+*/
+int roj_stft_job :: calc_prune_length (int a_length, int a_height){
+
+  for(int prune=a_height; prune<a_length; prune++)
+    if(a_length % prune == 0)
+      return prune;
+
+  return a_length;
+}
+
+/**
+* @type: method
+* @brief: This function expresses a window as a sum of complex exponentials whose frequencies are multiples of the inverse window length (up to ROJ_COSINE_ORDER). It is possible for cosine-sum windows and their derivatives, but not for time-ramped or chirped windows.
+*
+* @param [in] a_window: A pointer to the window.
+* @param [out] a_coefs: A pointer to 2*ROJ_COSINE_ORDER+1 coefficients (from the lowest frequency).
+*
+* @return: True if the window is represented exactly, false otherwise.
+*/
+bool roj_stft_job :: calc_cosine_coefs (roj_complex_signal* a_window, complex double* a_coefs){
+
+  int order = ROJ_COSINE_ORDER;
+  int length = a_window->get_config().length;
+  if(length < 2*order+1)
+    return false;
+
+  double peak = 0.0;
+  for(int m=0; m<length; m++)
+    if(cabs(a_window->m_waveform[m]) > peak)
+      peak = cabs(a_window->m_waveform[m]);
+  
+  for(int i=-order; i<=order; i++){
+    complex double coef = 0.0;
+    for(int m=0; m<length; m++)
+      coef += a_window->m_waveform[m] * cexp(-1I * TWO_PI * (double)((i * m) % length) / length);
+    coef /= length;
+
+    /* negligible terms are not tracked */
+    if(cabs(coef) < 1E-12 * peak)
+      coef = 0.0;
+    a_coefs[i+order] = coef;
+  }
+
+  /* verify the representation */
+  for(int m=0; m<length; m++){
+    complex double sample = 0.0;
+    for(int i=-order; i<=order; i++)
+      sample += a_coefs[i+order] * cexp(1I * TWO_PI * (double)((i * m) % length) / length);
+    
+    if(cabs(sample - a_window->m_waveform[m]) > 1E-9 * peak)
+      return false;
+  }
+
+  return true;
+}
+
+/**
+* @type: method
+* @brief: This function returns the number of STFT columns calculated by one item of the sliding engine. The sliding DFT is initialized at the beginning of each item.
+*
+* @param [in] a_analyzer: A pointer to the analyzer.
+*
+* @return: The number of columns.
+*/
+int roj_stft_job :: calc_sliding_chunk (roj_xxt_analyzer* a_analyzer){
+
+  int width = a_analyzer->get_width();
+  int chunk = (width + a_analyzer->m_threads - 1) / a_analyzer->m_threads;
+  if(chunk > ROJ_SLIDING_REFRESH)
+    chunk = ROJ_SLIDING_REFRESH;
+
+  return chunk;
+}
+
+/**
+* @type: method
+* @brief: This function estimates the cost of one STFT column calculated by the sliding engine (in complex multiplications).
+*
+* @param [in] a_analyzer: A pointer to the analyzer.
+* @param [in] a_codes: Codes of calculated slots.
+*
+* @return: The estimated cost, or -1 if the sliding engine cannot be used.
+*/
+double roj_stft_job :: calc_sliding_cost (roj_xxt_analyzer* a_analyzer, std::vector<std::pair<int, int> > a_codes){
+
+  if(!a_analyzer->check_fixed_windows())
+    return -1;
+
+  int order = ROJ_COSINE_ORDER;
+  bool* used = new bool[2*order+1];
+  for(int i=0; i<2*order+1; i++)
+    used[i] = false;
+  
+  complex double* coefs = new complex double[2*order+1];
+  bool possible = true;
+  for(int s=0; s<a_codes.size() and possible; s++){
+    roj_complex_signal* window = a_analyzer->m_window_gen->get_window(a_codes[s].first, a_codes[s].second);
+    possible = calc_cosine_coefs(window, coefs);
+    for(int i=0; i<2*order+1; i++)
+      if(coefs[i] != 0.0)
+	used[i] = true;
+    delete window;
+  }
+
+  int terms = 0;
+  for(int i=0; i<2*order+1; i++)
+    if(used[i])
+      terms++;
+  
+  delete [] coefs;
+  delete [] used;
+  
+  if(!possible)
+    return -1;
+
+  double lines = a_analyzer->get_height() * terms;
+  double init = (double)a_analyzer->m_window_gen->get_length() / calc_sliding_chunk(a_analyzer);
+  return lines * (a_analyzer->m_hop + a_codes.size() + init);
+}
+
+/* ************************************************************************************************************************* */
+/**
+* @type: method
+* @brief: This routine allocates resources of a worker. The zero padding of FFT input is set only once.
+*
+* @param [in] a_worker: An index of the worker.
+*/
+void roj_stft_job :: begin (int a_worker){
+
+  int slots = m_codes.size();
+  int size = m_batch * slots * m_analyzer->m_bank_config.length;
+
+  /* state of sliding dft */
+  m_trackers[a_worker] = NULL;
+  if(m_engine==ROJ_SLIDING_ENGINE){
+    m_trackers[a_worker] = new complex double[m_analyzer->get_height() * m_terms];
+    size = 0;
+  }
+
+  m_window_gens[a_worker] = new roj_window_generator(*m_analyzer->m_window_gen);
+  m_windows[a_worker] = NULL;
+
+  m_in_buffers[a_worker] = roj_fftw(alloc_complex)(size);
+  m_out_buffers[a_worker] = roj_fftw(alloc_complex)(size);
+  memset(m_in_buffers[a_worker], 0x0, size * sizeof(roj_complex));
+}
+
+/**
+* @type: method
+* @brief: This routine releases resources of a worker.
+*
+* @param [in] a_worker: An index of the worker.
+*/
+void roj_stft_job :: end (int a_worker){
+
+  clear_windows(a_worker);
+  delete [] m_trackers[a_worker];
+  delete m_window_gens[a_worker];
+  roj_fftw(free)(m_out_buffers[a_worker]);
+  roj_fftw(free)(m_in_buffers[a_worker]);
+}
+
+/* ************************************************************************************************************************* */
+/**
+* @type: private
+* @brief: This routine selects windows of a worker for the current chirp-rate of its generator. Windows are taken from the cache or borrowed from the bank of the generator and cached.
+*
+* @param [in] a_worker: An index of the worker.
+*/
+void roj_stft_job :: load_windows (int a_worker){
+
+  std::map<double, roj_complex**>& cache = m_window_caches[a_worker];
+  double c_rate = m_window_gens[a_worker]->get_chirp_rate();
+
+  std::map<double, roj_complex**>::iterator i = cache.find(c_rate);
+  if(i != cache.end()){
+    m_windows[a_worker] = i->second;
+    return;
+  }
+
+  if(cache.size() >= m_cache_limit)
+    clear_windows(a_worker);
+
+  /* samples are borrowed from the bank of the generator */
+  roj_complex** windows = new roj_complex*[m_codes.size()];
+  for(int s=0; s<m_codes.size(); s++)
+    windows[s] = m_window_gens[a_worker]->borrow_window(m_codes[s].first, m_codes[s].second);
+
+  cache[c_rate] = windows;
+  m_windows[a_worker] = windows;
+}
+
+/**
+* @type: private
+* @brief: This routine releases all cached windows of a worker.
+*
+* @param [in] a_worker: An index of the worker.
+*/
+void roj_stft_job :: clear_windows (int a_worker){
+
+  std::map<double, roj_complex**>& cache = m_window_caches[a_worker];
+  std::map<double, roj_complex**>::iterator i = cache.begin();
+  for ( ; i != cache.end(); ++i)
+    delete [] i->second;
+
+  /* borrowed samples are released with the bank */
+  cache.clear();
+  m_window_gens[a_worker]->clear_bank();
+  m_windows[a_worker] = NULL;
+}
+
+/**
+* @type: private
+* @brief: This routine combines short transforms of the pruned FFT into lines of the analyzed band.
+*
+* @param [in] a_short: A pointer to short transforms of one frame (phases x prune length).
+* @param [out] a_lines: A pointer to the output buffer (of the height length).
+*/
+void roj_stft_job :: combine_lines (roj_complex* a_short, roj_complex* a_lines){
+
+  for(int k=0; k<m_analyzer->get_height(); k++){
+    complex double* twiddles = &m_twiddles[k*m_phases];
+    complex double line = 0.0;
+    for(int p=0; p<m_phases; p++)
+      line += twiddles[p] * a_short[p*m_prune+k];
+    a_lines[k] = line;
+  }
+}
+
+/* ************************************************************************************************************************* */
+/**
+* @type: method
+* @brief: This routine calculates STFT columns of one batch. Each frame is loaded once and it is multiplied by all windows, then all frames of the batch are transformed by one FFTW call.
+*
+* @param [in] a_item: An index of the batch.
+* @param [in] a_worker: An index of the worker.
+*/
+void roj_stft_job :: execute (int a_item, int a_worker){
+
+  if(m_engine==ROJ_SLIDING_ENGINE){
+    execute_sliding(a_item, a_worker);
+    return;
+  }
+
+  if(m_bins!=NULL){
+    execute_dense(a_item, a_worker);
+    return;
+  }
+  
+  roj_xxt_analyzer* an = m_analyzer;
+  roj_complex* in_tmp = m_in_buffers[a_worker];
+  roj_complex* out_tmp = m_out_buffers[a_worker];
+
+  int slots = m_codes.size();
+  int length = an->m_bank_config.length;
+  int win_length = an->m_window_gen->get_length();
+  int start_index = (length-win_length) / 2;
+
+  int n = a_item * m_batch;
+  int count = get_count() - n;
+  if(count > m_batch)
+    count = m_batch;
+
+  for(int b=0; b<count; b++){
+
+    /* windows are selected again only if they are changed */
+    int column = get_column(n+b);
+    bool changed = an->update_window(column, m_window_gens[a_worker]);
+    if(changed or m_windows[a_worker]==NULL)
+      load_windows(a_worker);
+    roj_complex** windows = m_windows[a_worker];
+
+    roj_complex* source = &an->m_input_signal->m_waveform[column*an->m_hop];
+    if(m_real){
+      roj_real* frame = &((roj_real*)in_tmp)[b*slots*length + start_index];
+      for(int m=0; m<win_length; m++){
+	double sample = creal(source[m]);
+	for(int s=0; s<slots; s++)
+	  frame[s*length+m] = sample * creal(windows[s][m]);
+      }
+    }
+    else if(m_engine==ROJ_PRUNED_ENGINE){
+      roj_complex* frame = &in_tmp[b*slots*length];
+      for(int m=0; m<win_length; m++){
+	complex double sample = source[m] * m_demodulation[m];
+	for(int s=0; s<slots; s++)
+	  frame[s*length+m_positions[m]] = sample * windows[s][m];
+      }
+    }
+    else{
+      roj_complex* frame = &in_tmp[b*slots*length + start_index];
+      for(int m=0; m<win_length; m++){
+	complex double sample = source[m];
+	for(int s=0; s<slots; s++)
+	  frame[s*length+m] = sample * windows[s][m];
+      }
+    }
+  }
+
+  if(m_real){
+    int half = length/2 + 1;
+    roj_fft_plan_cache :: execute_r2c(length, (roj_real*)in_tmp, out_tmp, count*slots);
+    for(int b=0; b<count; b++)
+      for(int s=0; s<slots; s++)
+	an->copy_half_lines(&out_tmp[(b*slots+s)*half], m_stft[s][get_column(n+b)]);
+  }
+  else if(m_engine==ROJ_PRUNED_ENGINE){
+    roj_fft_plan_cache :: execute(m_prune, FFTW_FORWARD, in_tmp, out_tmp, count*slots*m_phases);
+    for(int b=0; b<count; b++)
+      for(int s=0; s<slots; s++)
+	combine_lines(&out_tmp[(b*slots+s)*length], m_stft[s][get_column(n+b)]);
+  }
+  else{
+    roj_fft_plan_cache :: execute(length, FFTW_FORWARD, in_tmp, out_tmp, count*slots);
+    for(int b=0; b<count; b++)
+      for(int s=0; s<slots; s++)
+	an->copy_lines(&out_tmp[(b*slots+s)*length], m_stft[s][get_column(n+b)]);
+  }
+
+  print_progress(finish_items(count), get_count(), "stft");
+}
+
+/**
+* @type: private
+* @brief: This routine calculates STFT columns of one batch for chirp-rate bins of pixels. Bins present in a column are transformed in groups of the batch size. Each sample of the frame is loaded once and it is multiplied by windows of all bins of a group, then lines of each bin are copied only to its pixels.
+*
+* @param [in] a_item: An index of the batch.
+* @param [in] a_worker: An index of the worker.
+*/
+void roj_stft_job :: execute_dense (int a_item, int a_worker){
+
+  roj_xxt_analyzer* an = m_analyzer;
+  roj_complex* in_tmp = m_in_buffers[a_worker];
+  roj_complex* out_tmp = m_out_buffers[a_worker];
+
+  int slots = m_codes.size();
+  int length = an->m_bank_config.length;
+  int height = an->get_height();
+  int win_length = an->m_window_gen->get_length();
+  int start_index = (length-win_length) / 2;
+
+  int n = a_item * m_batch;
+  int count = get_count() - n;
+  if(count > m_batch)
+    count = m_batch;
+
+  roj_complex* line = new roj_complex[height];
+  roj_complex*** windows = new roj_complex**[m_batch];
+  std::vector<int> bins;
+  std::vector<bool> used(m_bins->count, false);
+
+  for(int b=0; b<count; b++){
+
+    /* bins present in the column */
+    int column = get_column(n+b);
+    int* pixels = m_bins->pixels[column];
+    bins.clear();
+    for(int k=0; k<height; k++)
+      if(!used[pixels[k]]){
+	used[pixels[k]] = true;
+	bins.push_back(pixels[k]);
+      }
+
+    roj_complex* source = &an->m_input_signal->m_waveform[column*an->m_hop];
+    for(int g=0; g<bins.size(); g+=m_batch){
+
+      int group = bins.size() - g;
+      if(group > m_batch)
+	group = m_batch;
+
+      for(int j=0; j<group; j++){
+	m_window_gens[a_worker]->set_chirp_rate(m_bins->rates[bins[g+j]]);
+	load_windows(a_worker);
+	windows[j] = m_windows[a_worker];
+      }
+
+      if(m_engine==ROJ_PRUNED_ENGINE){
+	for(int m=0; m<win_length; m++){
+	  complex double sample = source[m] * m_demodulation[m];
+	  for(int j=0; j<group; j++)
+	    for(int s=0; s<slots; s++)
+	      in_tmp[(j*slots+s)*length+m_positions[m]] = sample * windows[j][s][m];
+	}
+	roj_fft_plan_cache :: execute(m_prune, FFTW_FORWARD, in_tmp, out_tmp, group*slots*m_phases);
+      }
+      else{
+	for(int m=0; m<win_length; m++){
+	  complex double sample = source[m];
+	  for(int j=0; j<group; j++)
+	    for(int s=0; s<slots; s++)
+	      in_tmp[(j*slots+s)*length+start_index+m] = sample * windows[j][s][m];
+	}
+	roj_fft_plan_cache :: execute(length, FFTW_FORWARD, in_tmp, out_tmp, group*slots);
+      }
+
+      for(int j=0; j<group; j++)
+	for(int s=0; s<slots; s++){
+	  if(m_engine==ROJ_PRUNED_ENGINE)
+	    combine_lines(&out_tmp[(j*slots+s)*length], line);
+	  else
+	    an->copy_lines(&out_tmp[(j*slots+s)*length], line);
+
+	  roj_complex* stft = m_stft[s][column];
+	  for(int k=0; k<height; k++)
+	    if(pixels[k] == bins[g+j])
+	      stft[k] = line[k];
+	}
+    }
+
+    for(int i=0; i<bins.size(); i++)
+      used[bins[i]] = false;
+  }
+
+  delete [] windows;
+  delete [] line;
+  print_progress(finish_items(count), get_count(), "stft");
+}
+
+/**
+* @type: private
+* @brief: This routine calculates STFT columns of one item by the sliding DFT. Rectangular DFTs are initialized directly for the first column, then they are updated sample by sample. Each line of each slot is a combination of these DFTs.
+*
+* @param [in] a_item: An index of the item.
+* @param [in] a_worker: An index of the worker.
+*/
+void roj_stft_job :: execute_sliding (int a_item, int a_worker){
+
+  roj_xxt_analyzer* an = m_analyzer;
+  complex double* trackers = m_trackers[a_worker];
+  roj_complex* signal = an->m_input_signal->m_waveform;
+
+  int slots = m_codes.size();
+  int size = an->get_height() * m_terms;
+  int win_length = an->m_window_gen->get_length();
+
+  int n = a_item * m_batch;
+  int count = an->get_width() - n;
+  if(count > m_batch)
+    count = m_batch;
+
+  /* initialization of rectangular dfts */
+  int curr_index = n*an->m_hop;
+  for(int j=0; j<size; j++){
+    complex double rotation = conj(m_rotations[j]);
+    complex double phasor = 1.0;
+    complex double tracker = 0.0;
+    for(int m=0; m<win_length; m++){
+      tracker += signal[curr_index+m] * phasor;
+      phasor *= rotation;
+    }
+    trackers[j] = tracker;
+  }
+  
+  for(int c=0; c<count; c++){
+
+    /* update by samples of the hop */
+    if(c>0)
+      for(int h=0; h<an->m_hop; h++){
+	complex double leaving = signal[curr_index];
+	complex double entering = signal[curr_index+win_length];
+	for(int j=0; j<size; j++)
+	  trackers[j] = m_rotations[j] * (trackers[j] - leaving + entering * m_tails[j]);
+	curr_index++;
+      }
+
+    for(int s=0; s<slots; s++){
+      complex double* coefs = m_coefs[s];
+      roj_complex* lines = m_stft[s][n+c];
+      for(int k=0; k<an->get_height(); k++){
+	complex double line = 0.0;
+	for(int t=0; t<m_terms; t++)
+	  line += coefs[k*m_terms+t] * trackers[k*m_terms+t];
+	lines[k] = line;
+      }
+    }
+  }
+  
+  print_progress(finish_items(count), an->get_width(), "stft");
+}
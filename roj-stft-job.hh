@@ -0,0 +1,109 @@
+/* *************************************************** *
+ * This file is a part of ccROJ project (version 0-49) *
+ * distributed under GNU General Public License v3.0.  *
+ * Please visit the webpage: github.com/dsp-box/ccROJ  *
+ * for more information.                               *
+ *                       contact: Krzysztof Czarnecki  *
+ *                email: czarnecki.krzysiek@gmail.com  *
+ * *************************************************** */
+
+#ifndef _roj_stft_job_
+#define _roj_stft_job_
+
+/**
+* @type: class
+* @brief: Definition of roj_stft_job class. It calculates STFT of a xxt analyzer for many windows. An item of the job is a batch of frames. Each worker owns its window generator, windows and FFT buffers. Windows of each chirp-rate are generated once by a worker and kept in its cache, so columns of a chirp-rate which appeared before reuse them. If the analyzer gives chirp-rate bins of pixels, each frame is transformed with windows of all bins present in its column.
+* @herit: roj_stft_job : roj_parallel_job
+*/
+
+/* ************************************************************************************************************************* */
+/* headers and declarations */
+
+#include "roj-parallel.hh"
+class roj_parallel_job;
+
+#include "roj-window-gener.hh"
+class roj_window_generator;
+
+#include "roj-fft-plan.hh"
+class roj_fft_plan_cache;
+
+class roj_xxt_analyzer;
+struct roj_chirp_bins;
+
+/* ************************************************************************************************************************* */
+/* stft job class definition */
+
+class roj_stft_job
+  : public roj_parallel_job{
+
+private:
+  
+  roj_xxt_analyzer* m_analyzer;
+  std::vector<std::pair<int, int> > m_codes;
+  roj_complex*** m_stft;
+  int m_batch;
+
+  /* calculated columns (all if empty) */
+  std::vector<int> m_columns;
+  int get_column(int);
+  int get_count();
+
+  /* real signal and windows (r2c transforms) */
+  bool m_real;
+
+  /* pruned fft: length of short transforms,
+     number of phases, sample positions, 
+     band demodulation and twiddle factors */
+  int m_engine;
+  int m_prune;
+  int m_phases;
+  int* m_positions;
+  complex double* m_demodulation;
+  complex double* m_twiddles;
+  
+  /* sliding dft: number of tracked frequencies for each line,
+     rotation and tail factors, combination coefficients of slots */
+  int m_terms;
+  complex double* m_rotations;
+  complex double* m_tails;
+  complex double** m_coefs;
+  complex double** m_trackers;
+  
+  /* chirp-rate bins of pixels (dense chirplet transform) */
+  roj_chirp_bins* m_bins;
+  unsigned int m_cache_limit;
+
+  /* worker resources */
+  roj_window_generator** m_window_gens;
+  roj_complex*** m_windows;
+  std::map<double, roj_complex**>* m_window_caches;
+  roj_complex** m_in_buffers;
+  roj_complex** m_out_buffers;
+
+  void load_windows(int);
+  void clear_windows(int);
+  void combine_lines(roj_complex*, roj_complex*);
+
+  void execute_sliding(int, int);
+  void execute_dense(int, int);
+
+  void begin(int);
+  void end(int);
+  void execute(int, int);
+  
+public:
+
+  /* construction */
+  roj_stft_job(roj_xxt_analyzer*, std::vector<std::pair<int, int> >, roj_complex***, int, bool, int =ROJ_FFT_ENGINE);
+  ~roj_stft_job();
+
+  void set_columns(std::vector<int>);
+
+  static int calc_prune_length(int, int);
+  static bool calc_cosine_coefs(roj_complex_signal*, complex double*);
+  static int calc_sliding_chunk(roj_xxt_analyzer*);
+  static double calc_sliding_cost(roj_xxt_analyzer*, std::vector<std::pair<int, int> >);
+};
+
+#endif
@@ -0,0 +1,302 @@
+/* *************************************************** *
+ * This file is a part of ccROJ project (version 0-49) *
+ * distributed under GNU General Public License v3.0.  *
+ * Please visit the webpage: github.com/dsp-box/ccROJ  *
+ * for more information.                               *
+ *                       contact: Krzysztof Czarnecki  *
+ *                email: czarnecki.krzysiek@gmail.com  *
+ * *************************************************** */
+
+#include "roj-stft-stream.hh"
+
+/* ************************************************************************************************************************* */
+/**
+* @type: destructor
+* @brief: This is a sink destructor.
+*/
+roj_column_sink :: ~roj_column_sink (){
+}
+
+/* ************************************************************************************************************************* */
+/**
+* @type: constructor
+* @brief: This is a constructor of roj_stft_stream.
+*
+* @param [in] a_bank_conf: A bank configuration (frequency axis).
+* @param [in] a_window_gen: A pointer to a window generator.
+* @param [in] a_hop (default 1): A hopsize.
+* @param [in] a_start (default 0.0): Time of the first sample.
+*/
+roj_stft_stream :: roj_stft_stream (roj_array_config a_bank_conf, roj_window_generator* a_window_gen, int a_hop, double a_start){
+
+  if(a_window_gen==NULL){
+    call_warning("in roj_stft_stream :: roj_stft_stream");
+    call_error("arg is null");
+  }
+
+  if(a_hop<1){
+    call_warning("in roj_stft_stream :: roj_stft_stream");
+    call_error("hop < 1");
+  }
+
+  m_analyzer = new roj_fft_analyzer(a_bank_conf, a_window_gen);
+  m_sink = NULL;
+
+  m_rate = a_window_gen->get_rate();
+  m_win_length = a_window_gen->get_length();
+  m_hop = a_hop;
+  m_mask = DIST_ENERGY;
+
+  m_buffer = NULL;
+  m_filled = 0;
+  m_start = a_start;
+  m_columns = 0;
+
+  set_block_size();
+}
+
+/**
+* @type: destructor
+* @brief: This is a stream destructor. Samples which are not flushed are lost.
+*/
+roj_stft_stream :: ~roj_stft_stream (){
+
+  delete [] m_buffer;
+  delete m_analyzer;
+}
+
+/* ************************************************************************************************************************* */
+/**
+* @type: method
+* @brief: This function sets a sink, which receives finished columns.
+*
+* @param [in] a_sink: A pointer to a sink (it is not released by the stream).
+*/
+void roj_stft_stream :: set_sink (roj_column_sink* a_sink){
+
+  m_sink = a_sink;
+}
+
+/**
+* @type: method
+* @brief: This function sets distributions passed to the sink.
+*
+* @param [in] a_mask (default DIST_ENERGY): A bitwise or of DIST_* codes.
+*/
+void roj_stft_stream :: set_mask (int a_mask){
+
+  if(a_mask==0){
+    call_warning("in roj_stft_stream :: set_mask");
+    call_error("no distribution is requested");
+  }
+
+  m_mask = a_mask;
+}
+
+/**
+* @type: method
+* @brief: This function sets a number of columns calculated together. It can be changed only before the first sample is written.
+*
+* @param [in] a_block_size (default ROJ_STREAM_BLOCK): A number of columns (at least 2).
+*/
+void roj_stft_stream :: set_block_size (unsigned int a_block_size){
+
+  if(a_block_size<2){
+    call_warning("in roj_stft_stream :: set_block_size");
+    call_error("block size < 2");
+  }
+
+  if(m_filled>0 or m_columns>0){
+    call_warning("in roj_stft_stream :: set_block_size");
+    call_error("stream is already started");
+  }
+
+  m_block_size = a_block_size;
+
+  /* block columns and overlap with the next block */
+  m_capacity = m_block_size * m_hop + m_win_length - 1;
+  delete [] m_buffer;
+  m_buffer = new roj_complex[m_capacity];
+}
+
+/**
+* @type: method
+* @brief: This function sets a number of worker threads of the internal analyzer.
+*
+* @param [in] a_threads (default 1): A number of threads.
+*/
+void roj_stft_stream :: set_threads (unsigned int a_threads){
+
+  m_analyzer->set_threads(a_threads);
+}
+
+/**
+* @type: method
+* @brief: This function sets an engine of STFT calculation of the internal analyzer.
+*
+* @param [in] a_engine (default ROJ_AUTO_ENGINE): ROJ_AUTO_ENGINE, ROJ_FFT_ENGINE, ROJ_PRUNED_ENGINE or ROJ_SLIDING_ENGINE.
+*/
+void roj_stft_stream :: set_engine (int a_engine){
+
+  m_analyzer->set_engine(a_engine);
+}
+
+/* ************************************************************************************************************************* */
+/**
+* @type: method
+* @brief: This function appends samples to the stream. Whenever a block is complete, its columns are passed to the sink and only the overlap is kept.
+*
+* @param [in] a_samples: A pointer to samples.
+* @param [in] a_count: A number of samples.
+*/
+void roj_stft_stream :: write (roj_complex* a_samples, unsigned int a_count){
+
+  if(a_samples==NULL and a_count>0){
+    call_warning("in roj_stft_stream :: write");
+    call_error("arg is null");
+  }
+
+  while(a_count>0){
+
+    unsigned int count = m_capacity - m_filled;
+    if(count > a_count)
+      count = a_count;
+
+    memcpy(&m_buffer[m_filled], a_samples, count * sizeof(roj_complex));
+    m_filled += count;
+    a_samples += count;
+    a_count -= count;
+
+    if(m_filled == m_capacity){
+      processing(m_capacity, m_block_size);
+
+      /* the overlap starts with the first frame of the next block */
+      unsigned int shift = m_block_size * m_hop;
+      memmove(m_buffer, &m_buffer[shift], (m_filled - shift) * sizeof(roj_complex));
+      m_filled -= shift;
+      m_start += shift / m_rate;
+    }
+  }
+}
+
+/**
+* @type: method
+* @brief: This function appends samples of a signal to the stream.
+*
+* @param [in] a_signal: A pointer to a signal (its sampling rate has to be equal to the window rate).
+*/
+void roj_stft_stream :: write (roj_complex_signal* a_signal){
+
+  if(a_signal==NULL){
+    call_warning("in roj_stft_stream :: write");
+    call_error("arg is null");
+  }
+
+  roj_signal_config conf = a_signal->get_config();
+  if(conf.rate!=m_rate){
+    call_warning("in roj_stft_stream :: write");
+    call_error("signal and window sampling rates are different");
+  }
+
+  write(a_signal->m_waveform, conf.length);
+}
+
+/**
+* @type: method
+* @brief: This function passes all remaining columns to the sink. Columns of the flushed stream are the same as columns of the whole signal analyzed by roj_fft_analyzer. The stream can be used again for samples which follow.
+*/
+void roj_stft_stream :: flush (){
+
+  int columns = 0;
+  if(m_filled >= m_win_length)
+    columns = (m_filled - m_win_length + 1) / m_hop;
+
+  if(columns>0){
+
+    /* zero padding of one hop, so the analyzer accepts the block */
+    unsigned int length = columns * m_hop + m_hop + m_win_length - 1;
+    roj_complex* padded = new roj_complex[length];
+    memset(padded, 0x0, length * sizeof(roj_complex));
+    memcpy(padded, m_buffer, m_filled * sizeof(roj_complex));
+
+    roj_complex* buffer = m_buffer;
+    m_buffer = padded;
+    processing(length, columns);
+    m_buffer = buffer;
+    delete [] padded;
+  }
+
+  m_start += m_filled / m_rate;
+  m_filled = 0;
+}
+
+/**
+* @type: method
+* @brief: This function returns a number of columns passed to the sink.
+*
+* @return: A number of columns.
+*/
+unsigned long roj_stft_stream :: get_columns (){
+
+  return m_columns;
+}
+
+/* ************************************************************************************************************************* */
+/**
+* @type: private
+* @brief: This function analyzes buffered samples and passes columns to the sink. Slots and distributions of the block are released afterwards.
+*
+* @param [in] a_length: A number of buffered samples used by the block.
+* @param [in] a_columns: A number of columns passed to the sink.
+*/
+void roj_stft_stream :: processing (unsigned int a_length, unsigned int a_columns){
+
+  if(m_sink==NULL){
+    call_warning("in roj_stft_stream :: processing");
+    call_error("sink is not set");
+  }
+
+  roj_signal_config sig_conf;
+  sig_conf.length = a_length;
+  sig_conf.rate = m_rate;
+  sig_conf.start = m_start;
+
+  roj_complex_signal* block = new roj_complex_signal(sig_conf);
+  memcpy(block->m_waveform, m_buffer, a_length * sizeof(roj_complex));
+
+  m_analyzer->set_signal(block, m_hop);
+  delete block;
+
+  roj_estimator_images images = m_analyzer->get_distributions(m_mask);
+  roj_image_config img_conf = m_analyzer->get_image_config();
+  double step = m_hop / m_rate;
+
+  for(unsigned int n=0; n<a_columns; n++){
+
+    roj_estimator_maps maps;
+    maps.energy = images.energy ? images.energy->m_data[n] : NULL;
+    maps.ifreq_1 = images.ifreq_1 ? images.ifreq_1->m_data[n] : NULL;
+    maps.ifreq_2 = images.ifreq_2 ? images.ifreq_2->m_data[n] : NULL;
+    maps.delay = images.delay ? images.delay->m_data[n] : NULL;
+    maps.k_rate = images.k_rate ? images.k_rate->m_data[n] : NULL;
+    maps.m_rate = images.m_rate ? images.m_rate->m_data[n] : NULL;
+    maps.d_rate = images.d_rate ? images.d_rate->m_data[n] : NULL;
+    maps.f_rate = images.f_rate ? images.f_rate->m_data[n] : NULL;
+    maps.dof = images.dof ? images.dof->m_data[n] : NULL;
+
+    m_sink->write_column(img_conf.x.min + n * step, img_conf.y, maps);
+  }
+  m_columns += a_columns;
+
+  delete images.energy;
+  delete images.ifreq_1;
+  delete images.ifreq_2;
+  delete images.delay;
+  delete images.k_rate;
+  delete images.m_rate;
+  delete images.d_rate;
+  delete images.f_rate;
+  delete images.dof;
+
+  m_analyzer->clear_signal();
+}
@@ -0,0 +1,88 @@
+/* *************************************************** *
+ * This file is a part of ccROJ project (version 0-49) *
+ * distributed under GNU General Public License v3.0.  *
+ * Please visit the webpage: github.com/dsp-box/ccROJ  *
+ * for more information.                               *
+ *                       contact: Krzysztof Czarnecki  *
+ *                email: czarnecki.krzysiek@gmail.com  *
+ * *************************************************** */
+
+#ifndef _roj_stft_stream_
+#define _roj_stft_stream_
+
+/**
+* @type: class
+* @brief: Definition of roj_stft_stream and roj_column_sink classes. A stream accepts blocks of samples of any length. Only the window-length overlap is kept between blocks, and finished columns of requested distributions are passed to a sink, so long recordings are analyzed in constant memory.
+*/
+
+/* ************************************************************************************************************************* */
+/* headers and declarations */
+
+#include "roj-external.hh"
+#include "roj-misc.hh"
+
+#include "roj-fft-analyzer.hh"
+class roj_fft_analyzer;
+
+#include "roj-estim-kernel.hh"
+struct roj_estimator_maps;
+
+/* ************************************************************************************************************************* */
+/* sink class definition */
+
+class roj_column_sink{
+public:
+
+  virtual ~roj_column_sink();
+
+  /* column time, frequency axis and distributions of one column */
+  virtual void write_column(double, roj_array_config, roj_estimator_maps) =0;
+};
+
+/* ************************************************************************************************************************* */
+/* stream class definition */
+
+class roj_stft_stream{
+private:
+
+  /* internal analyzer (it gets consecutive blocks) */
+  roj_fft_analyzer* m_analyzer;
+  roj_column_sink* m_sink;
+
+  /* configuration */
+  double m_rate;
+  int m_win_length;
+  int m_hop;
+  int m_mask;
+  unsigned int m_block_size;
+
+  /* samples of the current block */
+  roj_complex* m_buffer;
+  unsigned int m_capacity;
+  unsigned int m_filled;
+  double m_start;
+  unsigned long m_columns;
+
+  void processing(unsigned int, unsigned int);
+  
+public:
+
+  /* construction */
+  roj_stft_stream(roj_array_config, roj_window_generator*, int =1, double =0.0);
+  ~roj_stft_stream();
+
+  /* configuration */
+  void set_sink(roj_column_sink*);
+  void set_mask(int =DIST_ENERGY);
+  void set_block_size(unsigned int =ROJ_STREAM_BLOCK);
+  void set_threads(unsigned int =1);
+  void set_engine(int =ROJ_AUTO_ENGINE);
+
+  /* streaming */
+  void write(roj_complex*, unsigned int);
+  void write(roj_complex_signal*);
+  void flush();
+  unsigned long get_columns();
+};
+
+#endif
@@ -38,14 +38,8 @@ roj_stft_transform :: roj_stft_transform (roj_image_config a_conf, roj_complex_s
     call_error("matrix configuration is failed");
   }
 
-  /* allocate memory */
-  m_spectrum = new complex double* [m_config.x.length];
-  int byte_size = m_config.y.length * sizeof(complex double);
-  for(int n=0; n<m_config.x.length; n++){
-
-    m_spectrum[n] = fftw_alloc_complex(m_config.y.length);
-    memset(m_spectrum[n], 0x0, byte_size);
-  }
+  /* allocate memory (one contiguous buffer) */
+  m_spectrum = allocate_complex_rows(m_config.x.length, m_config.y.length);
 }
 
 /**
@@ -54,9 +48,7 @@ roj_stft_transform :: roj_stft_transform (roj_image_config a_conf, roj_complex_s
 */
 roj_stft_transform :: ~roj_stft_transform (){
 
-  for(int n=0; n<m_config.x.length; n++)
-     fftw_free(m_spectrum[n]);
-  delete [] m_spectrum;
+  release_rows(m_spectrum);
 
   if(m_window != NULL)
     delete m_window;
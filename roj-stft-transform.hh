@@ -53,7 +53,7 @@ public:
    * @type: field
    * @brief: This field gives access to spectral lines.
    */
-  complex double** m_spectrum; 
+  roj_complex** m_spectrum; 
 
   /* public methods */
   /* ******************************/
@@ -28,12 +28,82 @@ roj_window_generator :: roj_window_generator (double a_rate){
   m_type = ROJ_BH_WINDOW;
   m_crate = 0.0;
   m_length = 3;
+  m_param = 0.0;
+  m_profiles_valid = false;
+}
+
+/**
+* @type: constructor
+* @brief: This is a copy constructor. Only the configuration is copied, the copy starts with an empty bank, so generators of different threads do not share tabulated windows.
+*
+* @param [in] a_gen: A copied generator.
+*/
+roj_window_generator :: roj_window_generator (const roj_window_generator& a_gen){
+
+  m_rate = a_gen.m_rate;
+  m_type = a_gen.m_type;
+  m_crate = a_gen.m_crate;
+  m_length = a_gen.m_length;
+  m_param = a_gen.m_param;
+  m_coefs = a_gen.m_coefs;
+  m_profiles_valid = false;
 }
 
 /**
 * @type: destructor
-* @brief: The deconstructor is default.
+* @brief: This is a generator destructor. It releases all tabulated windows.
+*/
+roj_window_generator :: ~roj_window_generator (){
+
+  clear_bank();
+}
+
+/**
+* @type: operator
+* @brief: Overloading of '=' operator. Only the configuration is copied and the bank is cleared.
+*
+* @param [in] a_gen: A copied generator.
+*
+* @return: A reference to this generator.
+*/
+roj_window_generator& roj_window_generator :: operator = (const roj_window_generator& a_gen){
+
+  if(this == &a_gen)
+    return *this;
+
+  clear_bank();
+  m_rate = a_gen.m_rate;
+  m_type = a_gen.m_type;
+  m_crate = a_gen.m_crate;
+  m_length = a_gen.m_length;
+  m_param = a_gen.m_param;
+  m_coefs = a_gen.m_coefs;
+  m_profiles_valid = false;
+  return *this;
+}
+
+/**
+* @type: operator
+* @brief: Overloading of '<' operator. It is required by std::map.
+*
+* @param [in] a_key: A compared key.
+*
+* @return: True if this key precedes the given key.
 */
+bool roj_window_key :: operator < (const roj_window_key& a_key) const{
+
+  if(type != a_key.type)
+    return type < a_key.type;
+  if(length != a_key.length)
+    return length < a_key.length;
+  if(param != a_key.param)
+    return param < a_key.param;
+  if(crate != a_key.crate)
+    return crate < a_key.crate;
+  if(d_order != a_key.d_order)
+    return d_order < a_key.d_order;
+  return t_order < a_key.t_order;
+}
 
 /* ************************************************************************************************************************* */
 /**
@@ -50,13 +120,82 @@ double roj_window_generator :: get_rate (){
 /* ************************************************************************************************************************* */
 /**
 * @type: method
-* @brief: Type setter. Checking is during generation.
+* @brief: Type setter. Checking is during generation. Note that the derivative of a Gaussian window is proportional to its time-ramped version, so the K estimator of chirp-rate is ill-conditioned for ROJ_GAUSS_WINDOW and similar shapes (Kaiser, DPSS), where the F and D estimators should be used.
 *
-* @param [in] a_code: A code of type.
+* @param [in] a_code: A code of type (ROJ_BH_WINDOW, ROJ_HANN_WINDOW, ROJ_COSINE_WINDOW, ROJ_GAUSS_WINDOW, ROJ_KAISER_WINDOW or ROJ_DPSS_WINDOW).
 */
 void roj_window_generator :: set_type (char a_code){
   
   m_type = a_code;
+  m_profiles_valid = false;
+}
+
+/**
+* @type: method
+* @brief: This routine returns the code of window type.
+*
+* @return: A code of type.
+*/
+char roj_window_generator :: get_type (){
+
+  return m_type;
+}
+
+/**
+* @type: method
+* @brief: This routine sets a shape parameter of the window: the standard deviation relative to the duration (ROJ_GAUSS_WINDOW), the shape factor beta (ROJ_KAISER_WINDOW) or the time-half-bandwidth product NW (ROJ_DPSS_WINDOW). Other windows do not use it.
+*
+* @param [in] a_param: A positive parameter, or zero for a default of the type.
+*/
+void roj_window_generator :: set_parameter (double a_param){
+
+  if(a_param<0){
+    call_warning("in roj_window_generator :: set_parameter");    
+    call_error("parameter < 0");
+  }
+  
+  m_param = a_param;
+  m_profiles_valid = false;
+}
+
+/**
+* @type: method
+* @brief: This routine returns the shape parameter used for the current window type.
+*
+* @return: The parameter (zero if the type does not use it).
+*/
+double roj_window_generator :: get_parameter (){
+
+  if(m_param>0)
+    return m_param;
+
+  switch(m_type){
+  case ROJ_GAUSS_WINDOW:
+    return WIN_GAUSS_SIGMA;
+  case ROJ_KAISER_WINDOW:
+    return WIN_KAISER_BETA;
+  case ROJ_DPSS_WINDOW:
+    return WIN_DPSS_NW;
+  }
+  return 0.0;
+}
+
+/**
+* @type: method
+* @brief: This routine sets coefficients of the generic cosine-sum window (ROJ_COSINE_WINDOW): w[n] = sum_k a_k cos(2 pi k n / length). The window is periodic as the Blackman-Harris window. The bank is cleared, so borrowed samples are not valid anymore.
+*
+* @param [in] a_coefs: Coefficients a_0, a_1, ... (with signs).
+*/
+void roj_window_generator :: set_cosine_coefs (std::vector<double> a_coefs){
+
+  if(a_coefs.empty()){
+    call_warning("in roj_window_generator :: set_cosine_coefs");    
+    call_error("no coefficients");
+  }
+  
+  m_coefs = a_coefs;
+  m_profiles_valid = false;
+  clear_bank();
 }
 
 /* ************************************************************************************************************************* */
@@ -73,6 +212,7 @@ void roj_window_generator :: set_length (int a_length){
     call_error("a_length <= 0");
   }
   m_length = a_length;
+  m_profiles_valid = false;
 }
 
 /**
@@ -97,7 +237,8 @@ int roj_window_generator :: get_length (){
 double roj_window_generator :: calc_duration (){
 
   /* len - 0.5 <- why ??? */
-  if (m_type==ROJ_BH_WINDOW) 
+  if (m_type==ROJ_BH_WINDOW or m_type==ROJ_HANN_WINDOW or m_type==ROJ_COSINE_WINDOW or
+      m_type==ROJ_GAUSS_WINDOW or m_type==ROJ_KAISER_WINDOW or m_type==ROJ_DPSS_WINDOW) 
     return ((double)m_length) / m_rate;
   
   else{
@@ -150,25 +291,136 @@ roj_complex_signal* roj_window_generator :: get_empty_window (){
   return win;
 }
 
+/* ************************************************************************************************************************* */
+/**
+* @type: private
+* @brief: This function returns a tabulated window for the current configuration. The window is calculated and added to the bank if it is not found. Its samples are stored in an aligned row and its gain is calculated once.
+*
+* @param [in] a_d_order: An order of of window derivative with respect to time.
+* @param [in] a_t_order: An order of power of timeramp which is multiplied by the window waveform.
+*
+* @return: A reference to the bank entry.
+*/
+roj_window_entry& roj_window_generator :: find_window (int a_d_order, int a_t_order){
+
+  roj_window_key key;
+  key.type = m_type;
+  key.length = m_length;
+  key.param = get_parameter();
+  key.crate = m_crate;
+  key.d_order = a_d_order;
+  key.t_order = a_t_order;
+
+  std::map<roj_window_key, roj_window_entry>::iterator i = m_bank.find(key);
+  if(i != m_bank.end())
+    return i->second;
+
+  roj_complex_signal* win = generate_window(a_d_order, a_t_order);
+
+  roj_window_entry entry;
+  entry.samples = allocate_complex_rows(1, m_length);
+  entry.gain = 0.0;
+  for(int n=0; n<m_length; n++){
+    entry.samples[0][n] = win->m_waveform[n];
+    entry.gain += cabs(win->m_waveform[n]);
+  }
+  delete win;
+
+  return m_bank[key] = entry;
+}
+
 /* ************************************************************************************************************************* */
 /**
 * @type: method
-* @brief: This function returns window as roj_complex_signal.
+* @brief: This function returns window as roj_complex_signal. The waveform is copied from the bank.
 *
 * @param [in] a_d_order (default 0): An order of of window derivative with respect to time.
 * @param [in] a_t_order (default 0): An order of power of timeramp which is multiplied by the window waveform.
 *
-* @return: A pointer to the window object (roj_complex_signal object).
+* @return: A pointer to the window object (roj_complex_signal object), it has to be released by the caller.
 */
 roj_complex_signal* roj_window_generator :: get_window (int a_d_order, int a_t_order){
 
+  roj_complex* samples = find_window(a_d_order, a_t_order).samples[0];
+
+  roj_complex_signal* win = get_empty_window();
+  memcpy(win->m_waveform, samples, m_length * sizeof(roj_complex));
+  return win;
+}
+
+/**
+* @type: method
+* @brief: This function returns window samples without copying. They are owned by the generator and they are valid until the bank is cleared or the generator is deleted. They must not be modified.
+*
+* @param [in] a_d_order (default 0): An order of of window derivative with respect to time.
+* @param [in] a_t_order (default 0): An order of power of timeramp which is multiplied by the window waveform.
+*
+* @return: A pointer to aligned samples (the window length).
+*/
+roj_complex* roj_window_generator :: borrow_window (int a_d_order, int a_t_order){
+
+  return find_window(a_d_order, a_t_order).samples[0];
+}
+
+/* ************************************************************************************************************************* */
+/**
+* @type: method
+* @brief: This function returns window gain. It is calculated once for each tabulated window.
+*
+* @param [in] a_d_order (default 0): An order of of window derivative with respect to time.
+* @param [in] a_t_order (default 0): An order of power of timeramp which is multiplied by the window waveform.
+*
+* @return: The window gain.
+*/
+double roj_window_generator :: calc_gain (int a_d_order, int a_t_order){
+
+  return find_window(a_d_order, a_t_order).gain;
+}
+
+/* ************************************************************************************************************************* */
+/**
+* @type: method
+* @brief: This function returns a number of tabulated windows.
+*
+* @return: A number of windows in the bank.
+*/
+unsigned int roj_window_generator :: get_bank_size (){
+
+  return m_bank.size();
+}
+
+/**
+* @type: method
+* @brief: This function releases all tabulated windows. Borrowed samples are not valid anymore.
+*/
+void roj_window_generator :: clear_bank (){
+
+  std::map<roj_window_key, roj_window_entry>::iterator i = m_bank.begin();
+  for ( ; i != m_bank.end(); ++i)
+    release_rows(i->second.samples);
+
+  m_bank.clear();
+}
+
+/* ************************************************************************************************************************* */
+/**
+* @type: private
+* @brief: This function calculates window as roj_complex_signal.
+*
+* @param [in] a_d_order: An order of of window derivative with respect to time.
+* @param [in] a_t_order: An order of power of timeramp which is multiplied by the window waveform.
+*
+* @return: A pointer to the window object (roj_complex_signal object).
+*/
+roj_complex_signal* roj_window_generator :: generate_window (int a_d_order, int a_t_order){
+
   if(a_t_order<0){
-    call_warning("in roj_window_generator :: get_window ");    
+    call_warning("in roj_window_generator :: generate_window");    
     call_error("time order < 0");
   }
 
   if(a_d_order<0){
-    call_warning("in roj_window_generator :: get_window ");    
+    call_warning("in roj_window_generator :: generate_window");    
     call_error("derivative order < 0");
   }
 
@@ -186,21 +438,37 @@ roj_complex_signal* roj_window_generator :: get_window (int a_d_order, int a_t_o
       win = get_blackman_harris_d2win();
       break;
     default:
-      call_warning("in roj_window_generator :: get_window ");    
+      call_warning("in roj_window_generator :: generate_window");    
+      call_error("derivative for this order for this window type is not defined");
+    }
+    break;
+  case ROJ_HANN_WINDOW:
+  case ROJ_COSINE_WINDOW:
+  case ROJ_GAUSS_WINDOW:
+  case ROJ_KAISER_WINDOW:
+  case ROJ_DPSS_WINDOW:
+    if(a_d_order>2){
+      call_warning("in roj_window_generator :: generate_window");    
       call_error("derivative for this order for this window type is not defined");
     }
+    win = get_profile_window(a_d_order);
     break;
   default:
-    call_warning("in roj_window_generator :: get_window ");    
+    call_warning("in roj_window_generator :: generate_window");    
     call_error("unknown window type");
   }
   
   /* multiply by timeramp */
   if(a_t_order>0)
     for(int n=0;n<m_length;n++){
-    
-      double ramp = (double)n/(m_length-1) - 0.5;  
-      ramp *= calc_duration();
+
+      double ramp;
+      if(m_type==ROJ_BH_WINDOW){
+	ramp = (double)n/(m_length-1) - 0.5;  
+	ramp *= calc_duration();
+      }
+      else
+	ramp = get_time(n);
 
       win->m_waveform[n] *= pow(ramp, a_t_order) ; 
     }    
@@ -210,24 +478,288 @@ roj_complex_signal* roj_window_generator :: get_window (int a_d_order, int a_t_o
 
 /* ************************************************************************************************************************* */
 /**
-* @type: method
-* @brief: This function returns window gain.
+* @type: private
+* @brief: This function returns time of a window sample with respect to the window middle, which is also the time of STFT column.
 *
-* @param [in] a_d_order (default 0): An order of of window derivative with respect to time.
-* @param [in] a_t_order (default 0): An order of power of timeramp which is multiplied by the window waveform.
+* @param [in] a_nr: An index of sample.
 *
-* @return: The window gain.
+* @return: Time in seconds.
 */
-double roj_window_generator :: calc_gain (int a_d_order, int a_t_order){
+double roj_window_generator :: get_time (int a_nr){
 
-  roj_complex_signal* win = get_window(a_d_order, a_t_order);
+  return (a_nr - 0.5 * (m_length-1)) / m_rate;
+}
 
-  double total = 0.0;
-  for(int n=0; n<m_length; n++)
-    total += cabs(win->m_waveform[n]);
+/**
+* @type: private
+* @brief: This function creates a chirped window or its derivative from the real profile of the window type. For the profile g(t) and chirp-rate c, the window is g(t) exp(-i pi c t^2), so its derivatives are (g' - i 2 pi c t g) exp(-i pi c t^2) and (g'' - i 4 pi c t g' - (i 2 pi c + (2 pi c t)^2) g) exp(-i pi c t^2).
+*
+* @param [in] a_d_order: An order of derivative (0, 1 or 2).
+*
+* @return: The window as roj_complex_signal object.
+*/
+roj_complex_signal* roj_window_generator :: get_profile_window (int a_d_order){
 
-  delete win;
-  return total;
+  prepare_profiles();
+  roj_complex_signal* win = get_empty_window();
+
+  double omega = TWO_PI * m_crate;
+  for(int n=0;n<m_length;n++){
+    double time = get_time(n);
+
+    complex double value = m_profiles[a_d_order][n];
+    if(a_d_order==1)
+      value -= 1I * omega * time * m_profiles[0][n];
+    if(a_d_order==2){
+      value -= 2I * omega * time * m_profiles[1][n];
+      value -= (1I * omega + pow(omega * time, 2.0)) * m_profiles[0][n];
+    }
+
+    if(m_crate!=0.0)
+      value *= cexp(-1I * M_PI * m_crate * pow(time, 2.0));
+    win->m_waveform[n] = value;
+  }
+
+  return win;
+}
+
+/**
+* @type: private
+* @brief: This function calculates real profiles of the current window type: the window and its first and second derivatives with respect to time. They are calculated once for a configuration.
+*/
+void roj_window_generator :: prepare_profiles (){
+
+  if(m_profiles_valid)
+    return;
+
+  for(int d=0; d<3; d++)
+    m_profiles[d].assign(m_length, 0.0);
+  
+  std::vector<double> coefs;
+  switch(m_type){
+  case ROJ_HANN_WINDOW:
+    coefs.push_back(0.5);
+    coefs.push_back(-0.5);
+    calc_cosine_profiles(coefs);
+    break;
+  case ROJ_COSINE_WINDOW:
+    if(m_coefs.empty()){
+      call_warning("in roj_window_generator :: prepare_profiles");    
+      call_error("cosine coefficients are not set");
+    }
+    calc_cosine_profiles(m_coefs);
+    break;
+  case ROJ_GAUSS_WINDOW:
+    calc_gauss_profiles();
+    break;
+  case ROJ_KAISER_WINDOW:
+    calc_kaiser_profiles();
+    break;
+  case ROJ_DPSS_WINDOW:
+    calc_dpss_profiles();
+    break;
+  default:
+    call_warning("in roj_window_generator :: prepare_profiles");    
+    call_error("unknown window type");
+  }
+  
+  m_profiles_valid = true;
+}
+
+/**
+* @type: private
+* @brief: This function calculates profiles of a periodic cosine-sum window (as the Blackman-Harris window).
+*
+* @param [in] a_coefs: Coefficients of cosine terms.
+*/
+void roj_window_generator :: calc_cosine_profiles (std::vector<double> a_coefs){
+
+  double duration = calc_duration();
+  for(int n=0;n<m_length;n++)
+    for(unsigned int k=0; k<a_coefs.size(); k++){
+      double arg = TWO_PI * k * (double)n / m_length;
+      double scale = TWO_PI * k / duration;
+      
+      m_profiles[0][n] += a_coefs[k] * cos(arg);
+      m_profiles[1][n] -= a_coefs[k] * scale * sin(arg);
+      m_profiles[2][n] -= a_coefs[k] * scale * scale * cos(arg);
+    }
+}
+
+/**
+* @type: private
+* @brief: This function calculates profiles of the Gaussian window exp(-t^2 / (2 sigma^2)), where sigma is given relative to the window duration.
+*/
+void roj_window_generator :: calc_gauss_profiles (){
+
+  double sigma = get_parameter() * calc_duration();
+  double var = sigma * sigma;
+  
+  for(int n=0;n<m_length;n++){
+    double time = get_time(n);
+    double value = exp(-0.5 * time * time / var);
+    
+    m_profiles[0][n] = value;
+    m_profiles[1][n] = -time / var * value;
+    m_profiles[2][n] = (time * time / var - 1.0) / var * value;
+  }
+}
+
+/**
+* @type: private
+* @brief: This function calculates profiles of the Kaiser window I0(beta sqrt(1-u^2)) / I0(beta), where u is time relative to the half of the window. The Bessel function is summed as a series in y = beta^2 (1-u^2) / 4, so the derivatives are also valid at window edges.
+*/
+void roj_window_generator :: calc_kaiser_profiles (){
+
+  double beta = get_parameter();
+  double half = 0.5 * (m_length-1) / m_rate;
+  if(m_length<2)
+    half = 1.0 / m_rate;
+
+  /* I0(beta) */
+  double norm = 0.0;
+  double term = 1.0;
+  double y = 0.25 * beta * beta;
+  for(int k=1; term > 1E-17 * norm; k++){
+    norm += term;
+    term *= y / ((double)k * k);
+  }
+  
+  for(int n=0;n<m_length;n++){
+    double u = get_time(n) / half;
+    y = 0.25 * beta * beta * (1.0 - u*u);
+
+    /* series of I0 and its first and second derivatives with respect to y */
+    double a0 = 0.0, a1 = 0.0, a2 = 0.0;
+    double t0 = 1.0, t1 = 1.0, t2 = 0.5;
+    for(int k=1; k<1000; k++){
+      a0 += t0;
+      a1 += t1;
+      a2 += t2;
+      if(t0 <= 1E-17 * a0 and t1 <= 1E-17 * a1 and t2 <= 1E-17 * a2)
+	break;
+      t0 *= y / ((double)k * k);
+      t1 *= y / ((double)k * (k+1));
+      t2 *= y / ((double)(k+2) * k);
+    }
+
+    /* dy/du = -beta^2 u / 2 and du/dt = 1 / half */
+    double dy = -0.5 * beta * beta * u;
+    m_profiles[0][n] = a0 / norm;
+    m_profiles[1][n] = a1 * dy / half / norm;
+    m_profiles[2][n] = (a2 * dy * dy - 0.5 * beta * beta * a1) / (half * half) / norm;
+  }
+}
+
+/**
+* @type: private
+* @brief: This function calculates profiles of the first discrete prolate spheroidal sequence (DPSS) of a given time-half-bandwidth product. The sequence is the eigenvector of the largest eigenvalue of a tridiagonal matrix, which is found by bisection and inverse iteration. The derivatives are obtained analytically from the band-limited continuation of the sequence: v(t) = sum_m sin(2 pi W (t-m)) / (pi (t-m)) v[m] / lambda, where lambda is the energy concentration. The window is normalized to a unit peak.
+*/
+void roj_window_generator :: calc_dpss_profiles (){
+
+  int length = m_length;
+  double bandwidth = get_parameter() / length;
+  if(bandwidth >= 0.5){
+    call_warning("in roj_window_generator :: calc_dpss_profiles");    
+    call_error("time-half-bandwidth product is too large for this length");
+  }
+
+  std::vector<double> diag(length), off(length, 0.0);
+  for(int n=0; n<length; n++){
+    diag[n] = pow(0.5 * (length-1-2*n), 2.0) * cos(TWO_PI * bandwidth);
+    if(n>0)
+      off[n] = 0.5 * n * (length-n);
+  }
+
+  /* the largest eigenvalue by bisection of the Sturm sequence */
+  double lower = diag[0], upper = diag[0];
+  for(int n=0; n<length; n++){
+    double radius = off[n] + (n+1<length ? off[n+1] : 0.0);
+    lower = fmin(lower, diag[n] - radius);
+    upper = fmax(upper, diag[n] + radius);
+  }
+  
+  for(int i=0; i<200 and upper-lower > 1E-15 * fmax(fabs(lower), fabs(upper)); i++){
+    double middle = 0.5 * (lower + upper);
+    int count = 0;
+    double q = 1.0;
+    for(int n=0; n<length; n++){
+      q = diag[n] - middle - (n>0 ? off[n]*off[n] / q : 0.0);
+      if(q == 0.0)
+	q = 1E-300;
+      if(q < 0.0)
+	count++;
+    }
+    if(count == length)
+      upper = middle;
+    else
+      lower = middle;
+  }
+
+  /* inverse iteration with a shift above the eigenvalue */
+  double shift = upper + 1E-10 * fmax(1.0, fabs(upper));
+  std::vector<double> vec(length, 1.0), c(length), x(length);
+  for(int i=0; i<3; i++){
+
+    /* tridiagonal solver of (T - shift) x = vec */
+    double b = diag[0] - shift;
+    x[0] = vec[0] / b;
+    for(int n=1; n<length; n++){
+      c[n] = off[n] / b;
+      b = diag[n] - shift - off[n] * c[n];
+      x[n] = (vec[n] - off[n] * x[n-1]) / b;
+    }
+    for(int n=length-2; n>=0; n--)
+      x[n] -= c[n+1] * x[n+1];
+
+    double norm = 0.0;
+    for(int n=0; n<length; n++)
+      norm += x[n] * x[n];
+    norm = sqrt(norm);
+    for(int n=0; n<length; n++)
+      vec[n] = x[n] / norm;
+  }
+
+  double peak = 0.0;
+  for(int n=0; n<length; n++)
+    if(fabs(vec[n]) > fabs(peak))
+      peak = vec[n];
+
+  /* kernel sin(a t) / (pi t) and its derivatives at integer lags */
+  double a = TWO_PI * bandwidth;
+  std::vector<double> k0(length), k1(length), k2(length);
+  k0[0] = 2.0 * bandwidth;
+  k1[0] = 0.0;
+  k2[0] = -a * a * a / (3.0 * M_PI);
+  for(int t=1; t<length; t++){
+    double sn = sin(a * t);
+    double cs = cos(a * t);
+    k0[t] = sn / (M_PI * t);
+    k1[t] = (a * t * cs - sn) / (M_PI * t * t);
+    k2[t] = (2.0 * sn - 2.0 * a * t * cs - a * a * t * t * sn) / (M_PI * t * t * t);
+  }
+
+  /* energy concentration and derivatives of the continuation */
+  double lambda = 0.0;
+  for(int n=0; n<length; n++){
+    double s0 = 0.0, s1 = 0.0, s2 = 0.0;
+    for(int m=0; m<length; m++){
+      int lag = n>m ? n-m : m-n;
+      double sign = n>=m ? 1.0 : -1.0;
+      s0 += k0[lag] * vec[m];
+      s1 += sign * k1[lag] * vec[m];
+      s2 += k2[lag] * vec[m];
+    }
+    lambda += vec[n] * s0;
+    m_profiles[1][n] = s1;
+    m_profiles[2][n] = s2;
+  }
+
+  for(int n=0; n<length; n++){
+    m_profiles[0][n] = vec[n] / peak;
+    m_profiles[1][n] *= m_rate / (lambda * peak);
+    m_profiles[2][n] *= m_rate * m_rate / (lambda * peak);
+  }
 }
 
 /* ************************************************************************************************************************* */
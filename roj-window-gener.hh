@@ -12,7 +12,7 @@
 
 /**
 * @type: class
-* @brief: Definitions of roj_window_generator class.
+* @brief: Definitions of roj_window_generator class. Each generated window variant is tabulated in a bank of the generator, so it is calculated only once.
 */
 
 /* ************************************************************************************************************************* */
@@ -24,6 +24,35 @@
 #include "roj-complex-signal.hh"
 class roj_complex_signal;
   
+/* ************************************************************************************************************************* */
+/* structure definitions */
+
+/**
+* @type: struct
+* @brief: This structure is a key of a tabulated window: a type, a length, a shape parameter, a chirp-rate, a derivative order and a time-ramp order.
+*/
+struct roj_window_key{
+
+  char type;
+  int length;
+  double param;
+  double crate;
+  int d_order;
+  int t_order;
+
+  bool operator < (const roj_window_key&) const;
+};
+
+/**
+* @type: struct
+* @brief: This structure contains a tabulated window: aligned samples (one row) and the window gain.
+*/
+struct roj_window_entry{
+
+  roj_complex** samples;
+  double gain;
+};
+
 /* ************************************************************************************************************************* */
 /* window generator class definition */
 
@@ -35,6 +64,10 @@ private:
   double m_rate;
   int m_length;
   char m_type;
+
+  /* shape parameter (zero for a default) and cosine-sum coefficients */
+  double m_param;
+  std::vector<double> m_coefs;
   
   /* Blackman-Harris window */
   roj_complex_signal* get_blackman_harris_win ();
@@ -42,12 +75,31 @@ private:
   roj_complex_signal* get_blackman_harris_d2win ();
   
   roj_complex_signal* get_empty_window ();
+  roj_complex_signal* generate_window (int, int);
+
+  /* other windows: real profile and its derivatives (d/dt, d2/dt2) */
+  bool m_profiles_valid;
+  std::vector<double> m_profiles[3];
+  void prepare_profiles ();
+  void calc_cosine_profiles (std::vector<double>);
+  void calc_gauss_profiles ();
+  void calc_kaiser_profiles ();
+  void calc_dpss_profiles ();
+  roj_complex_signal* get_profile_window (int);
+  double get_time (int);
+
+  /* tabulated windows */
+  std::map<roj_window_key, roj_window_entry> m_bank;
+  roj_window_entry& find_window (int, int);
 
  public:
 
   /* construction */
   /* ******************************** */
   roj_window_generator (double);
+  roj_window_generator (const roj_window_generator&);
+  ~roj_window_generator ();
+  roj_window_generator& operator = (const roj_window_generator&);
 
   /* getter/setter methods */
   /* ******************************** */
@@ -57,10 +109,20 @@ private:
   void set_length(int);
   int get_length();
   void set_type(char);
+  char get_type();
+  void set_parameter(double);
+  double get_parameter();
+  void set_cosine_coefs(std::vector<double>);
 
   /* window generation */
   /* ******************************** */
   roj_complex_signal* get_window(int =0, int =0);
+  roj_complex* borrow_window(int =0, int =0);
+
+  /* bank of tabulated windows */
+  /* ******************************** */
+  unsigned int get_bank_size();
+  void clear_bank();
 
   /* calc methods */
   /* ******************************** */
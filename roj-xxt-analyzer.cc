@@ -65,6 +65,28 @@ roj_xxt_analyzer :: roj_xxt_analyzer (roj_array_config a_bank_conf, roj_window_g
   /* init pointer to analyzed signal */
   m_input_signal = NULL;
 
+  /* batch size is chosen automatically */
+  m_batch_size = 0;
+
+  /* stft is calculated serially */
+  m_threads = 1;
+
+  /* stft engine is chosen automatically */
+  m_engine = ROJ_AUTO_ENGINE;
+
+  /* no slot is calculated */
+  for(int d=0; d<ROJ_SLOT_ORDERS; d++)
+    for(int t=0; t<ROJ_SLOT_ORDERS; t++){
+      m_fourier_spectra[d][t] = NULL;
+      m_slot_refs[d][t] = 0;
+      m_slot_stamps[d][t] = 0;
+    }
+
+  /* slot cache is not limited */
+  m_slot_budget = 0;
+  m_slot_clock = 0;
+  memset(&m_slot_stats, 0x0, sizeof(roj_slot_stats));
+
   /* update frequency range */
   double delta = m_window_gen->get_rate() / m_bank_config.length;
   int finish = (m_bank_config.max + m_window_gen->get_rate()/2) / delta;
@@ -88,37 +110,382 @@ roj_xxt_analyzer :: roj_xxt_analyzer (roj_array_config a_bank_conf, roj_window_g
 */
 roj_xxt_analyzer :: ~roj_xxt_analyzer(){
 
-  std::map<std::pair<int, int>, complex double **>::iterator i = m_fourier_spectra.begin();
-  for ( ; i != m_fourier_spectra.end(); ++i){
+  for(int d=0; d<ROJ_SLOT_ORDERS; d++)
+    for(int t=0; t<ROJ_SLOT_ORDERS; t++)
+      release_rows(m_fourier_spectra[d][t]);
+
+  delete m_window_gen;
+}
+
+/* ************************************************************************************************************************* */
+/**
+* @type: method
+* @brief: This function allocates memory for STFT. Columns are stored in one contiguous and aligned buffer.
+*
+* @return: A pointer to allocated buffer (it is released by release_rows).
+*/
+roj_complex ** roj_xxt_analyzer :: allocate_stft (){
 
-    for(int n=0;n<get_width();n++)
-      delete [] i->second[n];
-    delete [] i->second;
+  return allocate_complex_rows(get_width(), get_height());
+}
 
-    m_fourier_spectra.erase (i);
+/**
+* @type: method
+* @brief: This function calculates STFT slots which are not calculated yet. All of them are obtained in one pass over the signal. Invalidated columns of resident slots are calculated again.
+*
+* @param [in] a_codes: Codes of required slots (window derivative order and time-ramp order).
+*/
+void roj_xxt_analyzer :: prepare_slots (std::vector<std::pair<int, int> > a_codes){
+
+  std::vector<std::pair<int, int> > missing;
+  std::vector<std::pair<int, int> > stale;
+  for(unsigned int s=0; s<a_codes.size(); s++){
+    if(!check_slot(a_codes[s]))
+      missing.push_back(a_codes[s]);
+    else if(!m_stale_columns[a_codes[s].first][a_codes[s].second].empty())
+      stale.push_back(a_codes[s]);
+    else
+      m_slot_stats.hits++;
   }
 
-  delete m_window_gen;
+  /* requested slots cannot be evicted */
+  for(unsigned int s=0; s<a_codes.size(); s++)
+    m_slot_refs[a_codes[s].first][a_codes[s].second]++;
+
+  if(!missing.empty()){
+    fit_slot_budget(missing.size());
+    transforming(missing);
+    m_slot_stats.misses += missing.size();
+  }
+
+  if(!stale.empty())
+    refreshing(stale);
+
+  /* mark slots as recently used */
+  m_slot_clock++;
+  for(unsigned int s=0; s<a_codes.size(); s++){
+    m_slot_refs[a_codes[s].first][a_codes[s].second]--;
+    m_slot_stamps[a_codes[s].first][a_codes[s].second] = m_slot_clock;
+  }
+}
+
+/**
+* @type: private
+* @brief: This function returns memory occupied by one slot (in bytes).
+*
+* @return: A size of a slot.
+*/
+size_t roj_xxt_analyzer :: get_slot_bytes (){
+
+  size_t unit = ROJ_ALIGNMENT / sizeof(roj_complex);
+  size_t stride = (get_height() + unit - 1) / unit * unit;
+  return get_width() * (stride * sizeof(roj_complex) + sizeof(roj_complex*));
+}
+
+/**
+* @type: private
+* @brief: This function releases memory of a slot.
+*
+* @param [in] a_d: A derivative order.
+* @param [in] a_t: A time-ramp order.
+*/
+void roj_xxt_analyzer :: drop_slot (int a_d, int a_t){
+
+  if(m_fourier_spectra[a_d][a_t]==NULL)
+    return;
+
+  release_rows(m_fourier_spectra[a_d][a_t]);
+  m_fourier_spectra[a_d][a_t] = NULL;
+  m_stale_columns[a_d][a_t].clear();
+  m_slot_stats.resident_bytes -= get_slot_bytes();
+}
+
+/**
+* @type: private
+* @brief: This function evicts least recently used slots, so a given number of new slots fits into the memory budget. Referenced slots are not evicted.
+*
+* @param [in] a_slots: A number of new slots.
+*/
+void roj_xxt_analyzer :: fit_slot_budget (int a_slots){
+
+  if(m_slot_budget==0)
+    return;
+
+  size_t required = a_slots * get_slot_bytes();
+  while(m_slot_stats.resident_bytes + required > m_slot_budget){
+
+    /* find least recently used slot */
+    int lru_d = -1;
+    int lru_t = -1;
+    for(int d=0; d<ROJ_SLOT_ORDERS; d++)
+      for(int t=0; t<ROJ_SLOT_ORDERS; t++)
+	if(m_fourier_spectra[d][t]!=NULL and m_slot_refs[d][t]==0)
+	  if(lru_d<0 or m_slot_stamps[d][t] < m_slot_stamps[lru_d][lru_t]){
+	    lru_d = d;
+	    lru_t = t;
+	  }
+
+    if(lru_d<0){
+      call_warning("slot budget is exceeded");
+      return;
+    }
+
+    drop_slot(lru_d, lru_t);
+    m_slot_stats.evictions++;
+  }
+}
+
+/**
+* @type: private
+* @brief: This routine calculates short-time Fourier transforms (STFT) for many windows. Each frame of the input signal is loaded once and it is multiplied by all windows. Then all frames of a batch are transformed by one FFTW call (r2c if the signal and windows are real). Batches are distributed between worker threads. The resultant STFTs are stored in m_fourier_spectra.
+*
+* @param [in] a_codes: Codes of calculated slots (window derivative order and time-ramp order).
+* @param [in] a_columns (default empty): Indexes of calculated columns. If it is not empty, columns are overwritten in resident slots.
+*/
+void roj_xxt_analyzer :: transforming (std::vector<std::pair<int, int> > a_codes, std::vector<int> a_columns){
+
+  int slots = a_codes.size();
+  bool partial = !a_columns.empty();
+
+  /* allocate memory for stft of each slot */
+  roj_complex*** stft = new roj_complex**[slots];
+  for(int s=0; s<slots; s++)
+    stft[s] = partial ? get_slot(a_codes[s]) : allocate_stft();
+
+  /* r2c transforms are used for real signal and windows */
+  bool real = !m_input_signal->check_imag() and check_real_windows(a_codes);
+  int engine = select_engine(a_codes, real);
+
+  /* sliding dft needs consecutive columns */
+  if(partial and engine==ROJ_SLIDING_ENGINE)
+    engine = ROJ_FFT_ENGINE;
+
+  /* columns of one item */
+  int batch = get_batch_size(slots);
+  if(engine==ROJ_SLIDING_ENGINE)
+    batch = roj_stft_job :: calc_sliding_chunk(this);
+  
+  /* calculating spectra by fft */
+  int count = partial ? a_columns.size() : get_width();
+  roj_stft_job job(this, a_codes, stft, batch, real, engine);
+  job.set_columns(a_columns);
+  job.run((count+batch-1) / batch, m_threads);
+  print_progress(0, 0, "stft");
+
+  if(partial){
+    delete [] stft;
+    return;
+  }
+
+  for(int s=0; s<slots; s++)
+    m_fourier_spectra[a_codes[s].first][a_codes[s].second] = stft[s];
+  delete [] stft;
+
+  m_slot_stats.resident_bytes += slots * get_slot_bytes();
+  if(m_slot_stats.resident_bytes > m_slot_stats.peak_bytes)
+    m_slot_stats.peak_bytes = m_slot_stats.resident_bytes;
+}
+
+/**
+* @type: private
+* @brief: This routine calculates again invalidated columns of resident slots. Columns invalidated in any of given slots are calculated for all of them in one pass, so memory of slots is reused.
+*
+* @param [in] a_codes: Codes of resident slots with invalidated columns.
+*/
+void roj_xxt_analyzer :: refreshing (std::vector<std::pair<int, int> > a_codes){
+
+  int width = get_width();
+  std::vector<bool> stale(width, false);
+  for(unsigned int s=0; s<a_codes.size(); s++){
+    std::vector<bool>& slot_stale = m_stale_columns[a_codes[s].first][a_codes[s].second];
+    for(int n=0; n<width; n++)
+      if(slot_stale[n])
+	stale[n] = true;
+  }
+
+  std::vector<int> columns;
+  for(int n=0; n<width; n++)
+    if(stale[n])
+      columns.push_back(n);
+
+  transforming(a_codes, columns);
+
+  for(unsigned int s=0; s<a_codes.size(); s++)
+    m_stale_columns[a_codes[s].first][a_codes[s].second].clear();
+
+  m_slot_stats.refreshes += a_codes.size();
+  m_slot_stats.refreshed_columns += columns.size();
+}
+
+/**
+* @type: method
+* @brief: This function invalidates given columns of all resident slots (e.g. if their windows are changed). Memory of slots is kept and invalidated columns are calculated again when slots are requested. Slots which are not resident are not affected.
+*
+* @param [in] a_columns: Indexes of invalidated columns.
+*/
+void roj_xxt_analyzer :: invalidate_columns (std::vector<int> a_columns){
+
+  if(a_columns.empty())
+    return;
+
+  int width = get_width();
+  for(int d=0; d<ROJ_SLOT_ORDERS; d++)
+    for(int t=0; t<ROJ_SLOT_ORDERS; t++){
+      if(m_fourier_spectra[d][t]==NULL)
+	continue;
+
+      std::vector<bool>& stale = m_stale_columns[d][t];
+      if(stale.empty())
+	stale.assign(width, false);
+
+      for(unsigned int i=0; i<a_columns.size(); i++){
+	if(a_columns[i]<0 or a_columns[i]>=width){
+	  call_warning("in roj_xxt_analyzer :: invalidate_columns");
+	  call_error("column is out of range");
+	}
+	stale[a_columns[i]] = true;
+      }
+    }
+}
+
+/**
+* @type: method
+* @brief: This function checks if a slot is already calculated.
+*
+* @param [in] a_code: A slot code (window derivative order and time-ramp order).
+*
+* @return: True if the slot is calculated.
+*/
+bool roj_xxt_analyzer :: check_slot (std::pair<int, int> a_code){
+
+  if(a_code.first<0 or a_code.first>=ROJ_SLOT_ORDERS or a_code.second<0 or a_code.second>=ROJ_SLOT_ORDERS){
+    call_warning("in roj_xxt_analyzer :: check_slot");
+    call_error("slot code is out of range");
+  }
+
+  return m_fourier_spectra[a_code.first][a_code.second] != NULL;
 }
 
-/* ************************************************************************************************************************* */
 /**
 * @type: method
-* @brief: This function allocates memory for STFT.
+* @brief: This function returns a calculated slot. It should be resolved once, before loops over pixels.
+*
+* @param [in] a_code: A slot code (window derivative order and time-ramp order).
 *
-* @return: A pointer to allocated buffer.
+* @return: A pointer to STFT columns of the slot.
 */
-complex double ** roj_xxt_analyzer :: allocate_stft (){
+roj_complex ** roj_xxt_analyzer :: get_slot (std::pair<int, int> a_code){
+
+  if(!check_slot(a_code)){
+    call_warning("in roj_xxt_analyzer :: get_slot");
+    call_error("slot is not calculated");
+  }
 
-  complex double** stft = new complex double*[get_width()];
-  int byte_size = get_height() * sizeof(complex double);
+  return m_fourier_spectra[a_code.first][a_code.second];
+}
 
-  for(int n=0;n<get_width();n++){
-    stft[n] = new complex double[get_height()];
-    memset(stft[n], 0x0, byte_size);
+/**
+* @type: method
+* @brief: This function calculates requested distributions from STFT slots. Columns are processed in memory order by the estimator kernel, so all requested estimates of a column are obtained while the column is in cache.
+*
+* @param [in] a_images: Output distributions (NULL pointers are skipped). Required slots have to be calculated.
+* @param [in] a_name: A label of progress messages.
+*/
+void roj_xxt_analyzer :: estimating (roj_estimator_images a_images, const char* a_name){
+
+  roj_complex** slot_zero = check_slot(CODE_WIN_ZERO) ? get_slot(CODE_WIN_ZERO) : NULL;
+  roj_complex** slot_d = check_slot(CODE_WIN_D) ? get_slot(CODE_WIN_D) : NULL;
+  roj_complex** slot_d2 = check_slot(CODE_WIN_D2) ? get_slot(CODE_WIN_D2) : NULL;
+  roj_complex** slot_t = check_slot(CODE_WIN_T) ? get_slot(CODE_WIN_T) : NULL;
+  roj_complex** slot_t2 = check_slot(CODE_WIN_T2) ? get_slot(CODE_WIN_T2) : NULL;
+  roj_complex** slot_dt = check_slot(CODE_WIN_DT) ? get_slot(CODE_WIN_DT) : NULL;
+
+  int height = get_height();
+  int width = get_width();
+  double step = m_window_gen->get_rate() / m_bank_config.length;
+  double scale = 1.0 / ((double)m_bank_config.length * m_bank_config.length);
+  roj_estimator_kernel kernel(height);
+  
+  for(int n=0; n<width; n++){
+
+    roj_estimator_lines lines;
+    lines.y = slot_zero ? slot_zero[n] : NULL;
+    lines.yD = slot_d ? slot_d[n] : NULL;
+    lines.yD2 = slot_d2 ? slot_d2[n] : NULL;
+    lines.yT = slot_t ? slot_t[n] : NULL;
+    lines.yT2 = slot_t2 ? slot_t2[n] : NULL;
+    lines.yDT = slot_dt ? slot_dt[n] : NULL;
+
+    roj_estimator_maps maps;
+    maps.energy = a_images.energy ? a_images.energy->m_data[n] : NULL;
+    maps.ifreq_1 = a_images.ifreq_1 ? a_images.ifreq_1->m_data[n] : NULL;
+    maps.ifreq_2 = a_images.ifreq_2 ? a_images.ifreq_2->m_data[n] : NULL;
+    maps.delay = a_images.delay ? a_images.delay->m_data[n] : NULL;
+    maps.k_rate = a_images.k_rate ? a_images.k_rate->m_data[n] : NULL;
+    maps.m_rate = a_images.m_rate ? a_images.m_rate->m_data[n] : NULL;
+    maps.d_rate = a_images.d_rate ? a_images.d_rate->m_data[n] : NULL;
+    maps.f_rate = a_images.f_rate ? a_images.f_rate->m_data[n] : NULL;
+    maps.dof = a_images.dof ? a_images.dof->m_data[n] : NULL;
+
+    kernel.calc(lines, maps, m_bank_config.min, step, scale);
+    print_progress(n+1, width, a_name);
   }
 
-  return stft;
+  print_progress(0, 0, a_name);
+}
+
+/**
+* @type: method
+* @brief: This function copies lines of the analyzed band from FFT output. The output is not shifted, so the band is taken with a wrap-around.
+*
+* @param [in] a_fft: A pointer to FFT output (of the bank length).
+* @param [out] a_lines: A pointer to the output buffer (of the height length).
+*/
+void roj_xxt_analyzer :: copy_lines (roj_complex* a_fft, roj_complex* a_lines){
+
+  int length = m_bank_config.length;
+  int first = (get_initial() + (length+1)/2) % length;
+
+  int head = length - first;
+  if(head > get_height())
+    head = get_height();
+  
+  memcpy(a_lines, &a_fft[first], head * sizeof(roj_complex));
+  memcpy(&a_lines[head], a_fft, (get_height()-head) * sizeof(roj_complex));
+}
+
+/**
+* @type: method
+* @brief: This function copies lines of the analyzed band from r2c FFT output. Lines above the half of the bank length are obtained from Hermitian symmetry.
+*
+* @param [in] a_half: A pointer to r2c FFT output (length/2+1 lines).
+* @param [out] a_lines: A pointer to the output buffer (of the height length).
+*/
+void roj_xxt_analyzer :: copy_half_lines (roj_complex* a_half, roj_complex* a_lines){
+
+  int length = m_bank_config.length;
+  int first = (get_initial() + (length+1)/2) % length;
+
+  for(int k=0; k<get_height(); k++){
+    int index = (first+k) % length;
+    if(index <= length/2)
+      a_lines[k] = a_half[index];
+    else
+      a_lines[k] = conj(a_half[length-index]);
+  }
+}
+
+/**
+* @type: private
+* @brief: This function checks if windows of given slots are real for all columns. By default windows can change between columns, so false is returned.
+*
+* @param [in] a_codes: Codes of slots (window derivative order and time-ramp order).
+*
+* @return: True if all windows are real.
+*/
+bool roj_xxt_analyzer :: check_real_windows (std::vector<std::pair<int, int> > a_codes){
+
+  return false;
 }
 
 /* ************************************************************************************************************************* */
@@ -150,6 +517,234 @@ void roj_xxt_analyzer :: set_signal (roj_complex_signal* a_sig, int a_hop){
   }
 }
 
+/**
+* @type: method
+* @brief: This function removes the analyzed signal and releases all slots, so the analyzer can be used for another signal (e.g. the next block of a stream).
+*/
+void roj_xxt_analyzer :: clear_signal (){
+
+  if(m_input_signal==NULL)
+    return;
+  
+  for(int d=0; d<ROJ_SLOT_ORDERS; d++)
+    for(int t=0; t<ROJ_SLOT_ORDERS; t++){
+      drop_slot(d, t);
+      m_slot_refs[d][t] = 0;
+    }
+
+  delete m_input_signal;
+  m_input_signal = NULL;
+}
+
+/**
+* @type: method
+* @brief: This function sets a number of frames which are transformed by one FFTW call. Input and output buffers of a batch should fit into L2 cache.
+*
+* @param [in] a_batch_size (default 0): A number of frames. If it is 0, the size is derived from ROJ_L2_CACHE_SIZE.
+*/
+void roj_xxt_analyzer :: set_batch_size (unsigned int a_batch_size){
+
+  m_batch_size = a_batch_size;
+}
+
+/**
+* @type: method
+* @brief: This function sets a number of worker threads which calculate STFT columns. Each worker owns its buffers and window generator.
+*
+* @param [in] a_threads (default 1): A number of threads.
+*/
+void roj_xxt_analyzer :: set_threads (unsigned int a_threads){
+
+  if(a_threads<1){
+    call_warning("in roj_xxt_analyzer :: set_threads");
+    call_error("number of threads < 1");
+  }
+  
+  m_threads = a_threads;
+}
+
+/**
+* @type: method
+* @brief: This function sets a memory budget of the slot cache. If new slots do not fit into the budget, least recently used slots are released (they are recalculated when needed again).
+*
+* @param [in] a_bytes (default 0): A budget in bytes. If it is 0, the cache is not limited.
+*/
+void roj_xxt_analyzer :: set_slot_budget (size_t a_bytes){
+
+  m_slot_budget = a_bytes;
+}
+
+/**
+* @type: method
+* @brief: This function returns a slot and holds a reference to it. The slot is calculated if it is missing. A referenced slot is not released by the cache, so it can be shared with the caller until release_slot is called.
+*
+* @param [in] a_code: A slot code (window derivative order and time-ramp order).
+*
+* @return: A pointer to STFT columns of the slot (width x height, not normalized).
+*/
+roj_complex ** roj_xxt_analyzer :: acquire_slot (std::pair<int, int> a_code){
+
+  if(m_input_signal==NULL){
+    call_warning("in roj_xxt_analyzer :: acquire_slot");
+    call_error("signal is not loaded!");
+  }
+
+  std::vector<std::pair<int, int> > codes;
+  codes.push_back(a_code);
+  prepare_slots(codes);
+
+  m_slot_refs[a_code.first][a_code.second]++;
+  return get_slot(a_code);
+}
+
+/**
+* @type: method
+* @brief: This function releases a reference to a slot. The slot memory is released when it is not referenced anymore.
+*
+* @param [in] a_code: A slot code (window derivative order and time-ramp order).
+*/
+void roj_xxt_analyzer :: release_slot (std::pair<int, int> a_code){
+
+  if(!check_slot(a_code))
+    return;
+
+  int& refs = m_slot_refs[a_code.first][a_code.second];
+  if(refs > 0)
+    refs--;
+  
+  if(refs == 0)
+    drop_slot(a_code.first, a_code.second);
+}
+
+/**
+* @type: method
+* @brief: This function releases memory of all slots which are not referenced.
+*/
+void roj_xxt_analyzer :: release_slots (){
+
+  for(int d=0; d<ROJ_SLOT_ORDERS; d++)
+    for(int t=0; t<ROJ_SLOT_ORDERS; t++)
+      if(m_slot_refs[d][t]==0)
+	drop_slot(d, t);
+}
+
+/**
+* @type: method
+* @brief: This function returns statistics of the slot cache.
+*
+* @return: A structure with hit, miss and eviction counts and memory of resident slots.
+*/
+roj_slot_stats roj_xxt_analyzer :: get_slot_stats (){
+
+  return m_slot_stats;
+}
+
+/**
+* @type: method
+* @brief: This function sets an engine of STFT calculation. The pruned engine calculates only lines of the analyzed band, so it is faster for narrow bands. The sliding engine updates lines sample by sample, so it is faster for small hops.
+*
+* @param [in] a_engine (default ROJ_AUTO_ENGINE): ROJ_AUTO_ENGINE, ROJ_FFT_ENGINE, ROJ_PRUNED_ENGINE or ROJ_SLIDING_ENGINE.
+*/
+void roj_xxt_analyzer :: set_engine (int a_engine){
+
+  if(a_engine!=ROJ_AUTO_ENGINE and a_engine!=ROJ_FFT_ENGINE and a_engine!=ROJ_PRUNED_ENGINE and a_engine!=ROJ_SLIDING_ENGINE){
+    call_warning("in roj_xxt_analyzer :: set_engine");
+    call_error("unknown engine");
+  }
+  
+  m_engine = a_engine;
+}
+
+/**
+* @type: private
+* @brief: This function returns the engine used for STFT calculation. In the automatic mode, the engine with the lowest estimated cost is chosen. The sliding engine requires fixed cosine-sum windows, otherwise FFT is used.
+*
+* @param [in] a_codes: Codes of calculated slots.
+* @param [in] a_real: True if r2c transforms can be used by the FFT engine.
+*
+* @return: ROJ_FFT_ENGINE, ROJ_PRUNED_ENGINE or ROJ_SLIDING_ENGINE.
+*/
+int roj_xxt_analyzer :: select_engine (std::vector<std::pair<int, int> > a_codes, bool a_real){
+
+  if(m_engine==ROJ_FFT_ENGINE or m_engine==ROJ_PRUNED_ENGINE)
+    return m_engine;
+
+  double sliding_cost = roj_stft_job :: calc_sliding_cost(this, a_codes);
+  if(m_engine==ROJ_SLIDING_ENGINE){
+    if(sliding_cost >= 0)
+      return ROJ_SLIDING_ENGINE;
+    
+    call_warning("sliding dft cannot be used for these windows, fft is used");
+    return ROJ_FFT_ENGINE;
+  }
+  
+  double length = m_bank_config.length;
+  double prune = roj_stft_job :: calc_prune_length(m_bank_config.length, get_height());
+
+  double fft_cost = length * log2(length);
+  if(a_real)
+    fft_cost /= 2;
+  
+  double pruned_cost = length * log2(prune) + length * get_height() / prune;
+
+  int engine = ROJ_FFT_ENGINE;
+  double cost = fft_cost;
+  if(pruned_cost < fft_cost){
+    engine = ROJ_PRUNED_ENGINE;
+    cost = pruned_cost;
+  }
+
+  /* sliding cost is given for a column, not for a frame */
+  if(sliding_cost >= 0 and sliding_cost < cost * a_codes.size())
+    engine = ROJ_SLIDING_ENGINE;
+  
+  return engine;
+}
+
+/**
+* @type: private
+* @brief: This function checks if windows are the same for all columns. By default windows can change between columns.
+*
+* @return: True if windows are fixed.
+*/
+bool roj_xxt_analyzer :: check_fixed_windows (){
+
+  return false;
+}
+
+/**
+* @type: private
+* @brief: This function returns chirp-rate bins of pixels. By default all pixels of a column are taken from one transform, so there are no bins.
+*
+* @return: A pointer to bins or NULL.
+*/
+roj_chirp_bins* roj_xxt_analyzer :: get_chirp_bins (){
+
+  return NULL;
+}
+
+/**
+* @type: private
+* @brief: This function returns the number of frames transformed together.
+*
+* @param [in] a_slots (default 1): A number of windows applied to each frame.
+*
+* @return: Batch size (not greater than spectrogram width).
+*/
+unsigned int roj_xxt_analyzer :: get_batch_size (unsigned int a_slots){
+
+  unsigned int batch = m_batch_size;
+  if(batch == 0)
+    batch = ROJ_L2_CACHE_SIZE / (2 * a_slots * m_bank_config.length * sizeof(roj_complex));
+  
+  if(batch < 1)
+    batch = 1;
+  if(batch > get_width())
+    batch = get_width();
+
+  return batch;
+}
+
 /* ************************************************************************************************************************* */
 /**
 * @type: private
@@ -259,9 +854,10 @@ roj_stft_transform* roj_xxt_analyzer :: get_stft_transform (){
   roj_complex_signal* window = m_window_gen->get_window();
   roj_stft_transform* transform = new roj_stft_transform(config, window);
 
-  /* filtering  ({0,0} slot) */
-  if(m_fourier_spectra.count(CODE_WIN_ZERO) == 0)
-    m_fourier_spectra[CODE_WIN_ZERO] = transforming(0, 0);
+  /* filtering ({0,0} slot) */
+  std::vector<std::pair<int, int> > codes;
+  codes.push_back(CODE_WIN_ZERO);
+  prepare_slots(codes);
 
 #ifdef ROJ_DEBUG_ON
   double window_gain = m_window_gen->calc_gain();
@@ -269,12 +865,18 @@ roj_stft_transform* roj_xxt_analyzer :: get_stft_transform (){
 #endif
 
   /* calc stft */
+  roj_complex** slot = get_slot(CODE_WIN_ZERO);
   int sign = -2 * (get_initial()%2) +1;
-  for(int n=0; n<get_width(); n++){
-    for(int k=0; k<get_height(); k++)
-      transform->m_spectrum[n][k] =  sign * m_fourier_spectra[CODE_WIN_ZERO][n][k] / m_bank_config.length;
+  int height = get_height();
+  int width = get_width();
+  
+  for(int n=0; n<width; n++){
+    roj_complex* col = slot[n];
+    roj_complex* out = transform->m_spectrum[n];
+    for(int k=0; k<height; k++)
+      out[k] = sign * col[k] / m_bank_config.length;
 
-    print_progress(n+1, get_width(), "stft");
+    print_progress(n+1, width, "stft");
   }
   print_progress(0, 0, "stft");
 
@@ -290,11 +892,62 @@ roj_stft_transform* roj_xxt_analyzer :: get_stft_transform (){
 */
 roj_real_matrix* roj_xxt_analyzer :: get_spectral_energy (){
 
-  roj_stft_transform* c_stft = get_stft_transform ();  
-  roj_real_matrix* output = c_stft->get_spectral_energy ();
+  /* energy is obtained from {0,0} slot without STFT object */
+  roj_estimator_images images = get_distributions(DIST_ENERGY);
+  return images.energy;
+}
+
+/* ************************************************************************************************************************* */
+/**
+* @type: method
+* @brief: This function returns many distributions at once. All missing slots are calculated in one pass over the signal. Then all distributions are obtained in one pass over the slots, so the inverse of y and zero checks are shared.
+*
+* @param [in] a_mask: A bitwise or of DIST_* codes.
+*
+* @return: A structure with pointers to obtained distributions (NULL if not requested). They have to be released by the caller.
+*/
+roj_estimator_images roj_xxt_analyzer :: get_distributions (int a_mask){
+
+  /* check input signal */
+  if(m_input_signal==NULL){
+    call_warning("in roj_xxt_analyzer :: get_distributions");
+    call_error("signal is not loaded!");
+  }
+
+  /* required slots */
+  bool need_zero = a_mask & (DIST_ENERGY | DIST_IFREQ_1 | DIST_IFREQ_2 | DIST_DELAY | DIST_CR_K | DIST_CR_D | DIST_CR_F | DIST_DOF);
+  bool need_d = a_mask & (DIST_IFREQ_1 | DIST_IFREQ_2 | DIST_CR_K | DIST_CR_D | DIST_CR_F | DIST_CR_M | DIST_DOF);
+  bool need_t = a_mask & (DIST_IFREQ_2 | DIST_DELAY | DIST_CR_K | DIST_CR_D | DIST_CR_F | DIST_CR_M | DIST_DOF);
   
-  delete c_stft;
-  return output;
+  std::vector<std::pair<int, int> > codes;
+  if(need_zero)
+    codes.push_back(CODE_WIN_ZERO);
+  if(need_d)
+    codes.push_back(CODE_WIN_D);
+  if(need_t)
+    codes.push_back(CODE_WIN_T);
+  if(a_mask & (DIST_CR_D | DIST_CR_M))
+    codes.push_back(CODE_WIN_D2);
+  if(a_mask & (DIST_CR_F | DIST_CR_M))
+    codes.push_back(CODE_WIN_T2);
+  if(a_mask & (DIST_CR_D | DIST_CR_F))
+    codes.push_back(CODE_WIN_DT);
+  prepare_slots(codes);
+
+  /* make empty output objects */
+  roj_estimator_images images;
+  images.energy = a_mask & DIST_ENERGY ? create_empty_image() : NULL;
+  images.ifreq_1 = a_mask & DIST_IFREQ_1 ? create_empty_image() : NULL;
+  images.ifreq_2 = a_mask & DIST_IFREQ_2 ? create_empty_image() : NULL;
+  images.delay = a_mask & DIST_DELAY ? create_empty_image() : NULL;
+  images.k_rate = a_mask & DIST_CR_K ? create_empty_image() : NULL;
+  images.m_rate = a_mask & DIST_CR_M ? create_empty_image() : NULL;
+  images.d_rate = a_mask & DIST_CR_D ? create_empty_image() : NULL;
+  images.f_rate = a_mask & DIST_CR_F ? create_empty_image() : NULL;
+  images.dof = a_mask & DIST_DOF ? create_empty_image() : NULL;
+
+  estimating(images, "dists");
+  return images;
 }
 
 /* ************************************************************************************************************************* */
@@ -312,36 +965,21 @@ roj_real_matrix* roj_xxt_analyzer :: get_instantaneous_frequency_by_1_estimator
     call_error("signal is not loaded!");
   }
   
-  /* filtering  ({1,0} slot) */
-  if(m_fourier_spectra.count(CODE_WIN_D) == 0)
-    m_fourier_spectra[CODE_WIN_D] = transforming(1, 0);
-  
-  /* filtering  ({0,0} slot) */
-  if(m_fourier_spectra.count(CODE_WIN_ZERO) == 0)
-    m_fourier_spectra[CODE_WIN_ZERO] = transforming(0, 0);
-  
+  /* filtering ({1,0} and {0,0} slots in one pass) */
+  std::vector<std::pair<int, int> > codes;
+  codes.push_back(CODE_WIN_D);
+  codes.push_back(CODE_WIN_ZERO);
+  prepare_slots(codes);
+
   /* make empty output object */
   roj_real_matrix* output = create_empty_image();
 
   /* calc instantaneous frequency estimate */
-  for(int k=0; k<get_height(); k++){
-    double freq = m_bank_config.min + m_window_gen->get_rate() * (double)k/m_bank_config.length;
-    
-    for(int n=0; n<get_width(); n++){
-      
-      complex double y = m_fourier_spectra[CODE_WIN_ZERO][n][k]; 
-      complex double yD = m_fourier_spectra[CODE_WIN_D][n][k]; 
-
-      if(cabs(y)==0)
-	output->m_data[n][k] = 1E300;
-      else
-	output->m_data[n][k] = freq-cimag(yD/y) / TWO_PI;
-    }    
+  roj_estimator_images images;
+  memset(&images, 0x0, sizeof(roj_estimator_images));
+  images.ifreq_1 = output;
+  estimating(images, "i-freq");
 
-    print_progress(k+1, get_height(), "i-freq");
-  }
-
-  print_progress(0, 0, "i-freq");    
   return output;
 }
 
@@ -361,41 +999,22 @@ roj_real_matrix* roj_xxt_analyzer :: get_instantaneous_frequency_by_2_estimator
     call_error("signal is not loaded!");
   }
   
-  /* filtering ({0,1} slot) */
-  if(m_fourier_spectra.count(CODE_WIN_T) == 0)
-    m_fourier_spectra[CODE_WIN_T] = transforming(0, 1);
-  
-  /* filtering ({1,0} slot) */
-  if(m_fourier_spectra.count(CODE_WIN_D) == 0)
-    m_fourier_spectra[CODE_WIN_D] = transforming(1, 0);
-  
-  /* filtering  ({0,0} slot) */
-  if(m_fourier_spectra.count(CODE_WIN_ZERO) == 0)
-    m_fourier_spectra[CODE_WIN_ZERO] = transforming(0, 0);
+  /* filtering ({0,1}, {1,0} and {0,0} slots in one pass) */
+  std::vector<std::pair<int, int> > codes;
+  codes.push_back(CODE_WIN_T);
+  codes.push_back(CODE_WIN_D);
+  codes.push_back(CODE_WIN_ZERO);
+  prepare_slots(codes);
 
   /* make empty output object */
   roj_real_matrix* output = create_empty_image();
 
   /* calc instantaneous frequency estimate */
-  for(int k=0; k<get_height(); k++){
-    double freq = m_bank_config.min + m_window_gen->get_rate() * (double)k/m_bank_config.length;
-    
-    for(int n=0; n<get_width(); n++){
-      
-      complex double y = m_fourier_spectra[CODE_WIN_ZERO][n][k]; 
-      complex double yD = m_fourier_spectra[CODE_WIN_D][n][k];
-      complex double yT = m_fourier_spectra[CODE_WIN_T][n][k]; 
+  roj_estimator_images images;
+  memset(&images, 0x0, sizeof(roj_estimator_images));
+  images.ifreq_2 = output;
+  estimating(images, "i-freq");
 
-      if(cabs(y)==0)
-	output->m_data[n][k] = 1E300;
-      else
-	output->m_data[n][k] = freq+(creal(yD/yT)/cimag(y/yT)) / TWO_PI;
-    }    
-
-    print_progress(k+1, get_height(), "i-freq");
-  }
-
-  print_progress(0, 0, "i-freq");    
   return output;
 }
 
@@ -417,31 +1036,18 @@ roj_real_matrix* roj_xxt_analyzer :: get_spectral_delay (){
    /* make empty output object */
    roj_real_matrix* output = create_empty_image();
 
-   /* filtering ({0,1} slot) */
-   if(m_fourier_spectra.count(CODE_WIN_T) == 0)
-     m_fourier_spectra[CODE_WIN_T] = transforming(0, 1);
-
-   /* filtering  ({0,0} slot) */
-   if(m_fourier_spectra.count(CODE_WIN_ZERO) == 0)
-     m_fourier_spectra[CODE_WIN_ZERO] = transforming(0, 0);
+   /* filtering ({0,1} and {0,0} slots in one pass) */
+   std::vector<std::pair<int, int> > codes;
+   codes.push_back(CODE_WIN_T);
+   codes.push_back(CODE_WIN_ZERO);
+   prepare_slots(codes);
 
    /* calc spectral delay estimate */
-   for(int k=0; k<get_height(); k++){
-     for(int n=0; n<get_width(); n++){
-
-       complex double y = m_fourier_spectra[CODE_WIN_ZERO][n][k]; 
-       complex double yT = m_fourier_spectra[CODE_WIN_T][n][k];
-
-       if(cabs(y)==0)
-	 output->m_data[n][k] = 1E300;
-       else
-	 output->m_data[n][k] = creal(yT/y);
-     }
+   roj_estimator_images images;
+   memset(&images, 0x0, sizeof(roj_estimator_images));
+   images.delay = output;
+   estimating(images, "s-delay");
 
-     print_progress(k+1, get_height(), "s-delay");
-   }
-
-   print_progress(0, 0, "s-delay");
    return output;
 }
 
@@ -460,43 +1066,22 @@ roj_real_matrix* roj_xxt_analyzer :: get_chirp_rate_by_k_estimator (){
     call_error("signal is not loaded!");
   }
   
-  /* filtering ({0,1} slot) */
-  if(m_fourier_spectra.count(CODE_WIN_T) == 0)
-    m_fourier_spectra[CODE_WIN_T] = transforming(0, 1);
-
-  /* filtering  ({0,0} slot) */
-  if(m_fourier_spectra.count(CODE_WIN_ZERO) == 0)
-    m_fourier_spectra[CODE_WIN_ZERO] = transforming(0, 0);
+  /* filtering ({0,1}, {0,0} and {1,0} slots in one pass) */
+  std::vector<std::pair<int, int> > codes;
+  codes.push_back(CODE_WIN_T);
+  codes.push_back(CODE_WIN_ZERO);
+  codes.push_back(CODE_WIN_D);
+  prepare_slots(codes);
 
-  /* filtering  ({1,0} slot) */
-  if(m_fourier_spectra.count(CODE_WIN_D) == 0)
-    m_fourier_spectra[CODE_WIN_D] = transforming(1, 0);
-  
   /* make empty output object */
   roj_real_matrix* output = create_empty_image();
   
   /* calc chirp rate estimate */
-  for(int k=0; k<get_height(); k++){
+  roj_estimator_images images;
+  memset(&images, 0x0, sizeof(roj_estimator_images));
+  images.k_rate = output;
+  estimating(images, "c-rate");
 
-      for(int n=0; n<get_width(); n++){
-
-	complex double yD = m_fourier_spectra[CODE_WIN_D][n][k]; 
-	complex double y = m_fourier_spectra[CODE_WIN_ZERO][n][k]; 
-	complex double yT = m_fourier_spectra[CODE_WIN_T][n][k]; 
-
-	if(cabs(y)==0)
-	  output->m_data[n][k] = 1E300;
-	else{
-	  double nominative = creal(yD/y) / TWO_PI; 
-	  double denominative = cimag(yT/y); 
-	  output->m_data[n][k] = nominative / denominative;
-	}
-      }
-    
-    print_progress(k+1, get_height(), "c-rate");
-  }
-
-  print_progress(0, 0, "c-rate");
   return output;
 }
 
@@ -515,49 +1100,23 @@ roj_real_matrix* roj_xxt_analyzer :: get_chirp_rate_by_m_estimator (){
     call_error("signal is not loaded!");
   }
 
-  /* filtering  ({0,2} slot) */
-  if(m_fourier_spectra.count(CODE_WIN_T2) == 0)
-    m_fourier_spectra[CODE_WIN_T2] = transforming(0, 2);
-
-  /* filtering  ({0,1} slot) */
-  if(m_fourier_spectra.count(CODE_WIN_T) == 0)
-    m_fourier_spectra[CODE_WIN_T] = transforming(0, 1);
+  /* filtering ({0,2}, {0,1}, {1,0} and {2,0} slots in one pass) */
+  std::vector<std::pair<int, int> > codes;
+  codes.push_back(CODE_WIN_T2);
+  codes.push_back(CODE_WIN_T);
+  codes.push_back(CODE_WIN_D);
+  codes.push_back(CODE_WIN_D2);
+  prepare_slots(codes);
 
-  /* filtering  ({1,0} slot) */  
-  if(m_fourier_spectra.count(CODE_WIN_D) == 0)
-    m_fourier_spectra[CODE_WIN_D] = transforming(1, 0);
-  
-  /* filtering  ({2,0} slot) */  
-  if(m_fourier_spectra.count(CODE_WIN_D2) == 0)
-    m_fourier_spectra[CODE_WIN_D2] = transforming(2, 0);
-  
   /* make empty output object */
   roj_real_matrix* output = create_empty_image();
   
   /* calc chirp rate estimate */
-  for(int k=0; k<get_height(); k++){
-
-      for(int n=0; n<get_width(); n++){
-
-	complex double yD = m_fourier_spectra[CODE_WIN_D][n][k]; 
-	complex double yD2 = m_fourier_spectra[CODE_WIN_D2][n][k];
-	
-	complex double yT = m_fourier_spectra[CODE_WIN_T][n][k]; 
-	complex double yT2 = m_fourier_spectra[CODE_WIN_T2][n][k]; 
+  roj_estimator_images images;
+  memset(&images, 0x0, sizeof(roj_estimator_images));
+  images.m_rate = output;
+  estimating(images, "c-rate");
 
-	if(cabs(yD)==0 or cabs(yT)==0 or cabs(yT2)==0)
-	  output->m_data[n][k] = 1E300;
-	else{
-	  double nominative = creal(yD2/yD) / TWO_PI; 
-	  double denominative = cimag(yT2/yT); 
-	  output->m_data[n][k] = nominative / denominative;
-	}
-      }
-    
-    print_progress(k+1, get_height(), "c-rate");
-  }
-
-  print_progress(0, 0, "c-rate");
   return output;
 }
 
@@ -575,53 +1134,24 @@ roj_real_matrix* roj_xxt_analyzer :: get_chirp_rate_by_d_estimator (){
     call_error("signal is not loaded!");
   }
 
-  /* filtering  ({1,1} slot) */
-  if(m_fourier_spectra.count(CODE_WIN_DT) == 0)
-    m_fourier_spectra[CODE_WIN_DT] = transforming(1, 1);
-
-  /* filtering  ({0,1} slot) */
-  if(m_fourier_spectra.count(CODE_WIN_T) == 0)
-    m_fourier_spectra[CODE_WIN_T] = transforming(0, 1);
+  /* filtering ({1,1}, {0,1}, {0,0}, {1,0} and {2,0} slots in one pass) */
+  std::vector<std::pair<int, int> > codes;
+  codes.push_back(CODE_WIN_DT);
+  codes.push_back(CODE_WIN_T);
+  codes.push_back(CODE_WIN_ZERO);
+  codes.push_back(CODE_WIN_D);
+  codes.push_back(CODE_WIN_D2);
+  prepare_slots(codes);
 
-  /* filtering  ({0,0} slot) */
-  if(m_fourier_spectra.count(CODE_WIN_ZERO) == 0)
-    m_fourier_spectra[CODE_WIN_ZERO] = transforming(0, 0);
-
-  /* filtering  ({1,0} slot) */  
-  if(m_fourier_spectra.count(CODE_WIN_D) == 0)
-    m_fourier_spectra[CODE_WIN_D] = transforming(1, 0);
-  
-  /* filtering  ({2,0} slot) */  
-  if(m_fourier_spectra.count(CODE_WIN_D2) == 0)
-    m_fourier_spectra[CODE_WIN_D2] = transforming(2, 0);
-  
   /* make empty output object */
   roj_real_matrix* output = create_empty_image();
   
   /* calc chirp rate estimate */
-  for(int k=0; k<get_height(); k++){
-
-      for(int n=0; n<get_width(); n++){
-
-	complex double yD2 = m_fourier_spectra[CODE_WIN_D2][n][k]; 
-	complex double yD = m_fourier_spectra[CODE_WIN_D][n][k]; 
-	complex double y = m_fourier_spectra[CODE_WIN_ZERO][n][k]; 
-	complex double yT = m_fourier_spectra[CODE_WIN_T][n][k]; 
-	complex double yDT = m_fourier_spectra[CODE_WIN_DT][n][k]; 
-
-	if(cabs(y)==0)
-	  output->m_data[n][k] = 1E300;
-	else{
-	  double nominative = creal(yD2 / y - yD * yD / (y * y)) / TWO_PI;
-	  double denominative = cimag(yDT / y - yD * yT / (y * y));
-	  output->m_data[n][k] = nominative / denominative;
-	}
-      }
-    
-    print_progress(k+1, get_height(), "c-rate");
-  }
+  roj_estimator_images images;
+  memset(&images, 0x0, sizeof(roj_estimator_images));
+  images.d_rate = output;
+  estimating(images, "c-rate");
 
-  print_progress(0, 0, "c-rate");
   return output;
 }
 
@@ -639,53 +1169,24 @@ roj_real_matrix* roj_xxt_analyzer :: get_chirp_rate_by_f_estimator (){
     call_error("signal is not loaded!");
   }
   
-  /* filtering  ({1,1} slot) */
-  if(m_fourier_spectra.count(CODE_WIN_DT) == 0)
-    m_fourier_spectra[CODE_WIN_DT] = transforming(1, 1);
-
-  /* filtering  ({0,1} slot) */
-  if(m_fourier_spectra.count(CODE_WIN_T) == 0)
-    m_fourier_spectra[CODE_WIN_T] = transforming(0, 1);
+  /* filtering ({1,1}, {0,1}, {0,2}, {0,0} and {1,0} slots in one pass) */
+  std::vector<std::pair<int, int> > codes;
+  codes.push_back(CODE_WIN_DT);
+  codes.push_back(CODE_WIN_T);
+  codes.push_back(CODE_WIN_T2);
+  codes.push_back(CODE_WIN_ZERO);
+  codes.push_back(CODE_WIN_D);
+  prepare_slots(codes);
 
-  /* filtering  ({0,2} slot) */  
-  if(m_fourier_spectra.count(CODE_WIN_T2) == 0)
-    m_fourier_spectra[CODE_WIN_T2] = transforming(0, 2);
-
-  /* filtering  ({0,0} slot) */
-  if(m_fourier_spectra.count(CODE_WIN_ZERO) == 0)
-    m_fourier_spectra[CODE_WIN_ZERO] = transforming(0, 0);
-
-  /* filtering  ({1,0} slot) */  
-  if(m_fourier_spectra.count(CODE_WIN_D) == 0)
-    m_fourier_spectra[CODE_WIN_D] = transforming(1, 0);
-  
   /* make empty output object */
   roj_real_matrix* output = create_empty_image();
 
   /* calc chirp rate estimate */
-  for(int k=0; k<get_height(); k++){
-
-      for(int n=0; n<get_width(); n++){
-
-	complex double yD = m_fourier_spectra[CODE_WIN_D][n][k]; 
-	complex double y = m_fourier_spectra[CODE_WIN_ZERO][n][k]; 
-	complex double yT = m_fourier_spectra[CODE_WIN_T][n][k]; 
-	complex double yT2 = m_fourier_spectra[CODE_WIN_T2][n][k]; 
-	complex double yDT = m_fourier_spectra[CODE_WIN_DT][n][k]; 
-
-	if(cabs(y)==0)
-	  output->m_data[n][k] = 1E300;
-	else{
-	  double nominative = cimag(yDT / y - yD * yT / (y * y))  / TWO_PI;
-	  double denominative = creal(yT2 / y - yT * yT / (y * y));
-	  output->m_data[n][k] = -nominative / denominative;
-	}
-      }
-    
-    print_progress(k+1, get_height(), "c-rate");
-  }
+  roj_estimator_images images;
+  memset(&images, 0x0, sizeof(roj_estimator_images));
+  images.f_rate = output;
+  estimating(images, "c-rate");
 
-  print_progress(0, 0, "c-rate");
   return output;
 }
 
@@ -704,42 +1205,21 @@ roj_real_matrix* roj_xxt_analyzer :: get_dof_density (){
     call_error("signal is not loaded!");
   }
   
-  /* filtering ({0,1} slot) */
-  if(m_fourier_spectra.count(CODE_WIN_T) == 0)
-    m_fourier_spectra[CODE_WIN_T] = transforming(0, 1);
-  
-  /* filtering ({1,0} slot) */
-  if(m_fourier_spectra.count(CODE_WIN_D) == 0)
-    m_fourier_spectra[CODE_WIN_D] = transforming(1, 0);
-  
-  /* filtering  ({0,0} slot) */
-  if(m_fourier_spectra.count(CODE_WIN_ZERO) == 0)
-    m_fourier_spectra[CODE_WIN_ZERO] = transforming(0, 0);
+  /* filtering ({0,1}, {1,0} and {0,0} slots in one pass) */
+  std::vector<std::pair<int, int> > codes;
+  codes.push_back(CODE_WIN_T);
+  codes.push_back(CODE_WIN_D);
+  codes.push_back(CODE_WIN_ZERO);
+  prepare_slots(codes);
 
   /* make empty output object */
   roj_real_matrix* output = create_empty_image();
   
   /* calc chirp rate estimate */
-  for(int k=0; k<get_height(); k++){
-
-      for(int n=0; n<get_width(); n++){
-
-	complex double yD = m_fourier_spectra[CODE_WIN_D][n][k]; 
-	complex double y = m_fourier_spectra[CODE_WIN_ZERO][n][k]; 
-	complex double yT = m_fourier_spectra[CODE_WIN_T][n][k]; 
-
-	if(cabs(y)==0)
-	  output->m_data[n][k] = 1E300;
-	else{
-	  double nominative = creal(yD/y) / TWO_PI; 
-	  double denominative = cimag(yT/y);
-	  output->m_data[n][k] = abs(nominative * denominative);
-	}
-      }
-    
-    print_progress(k+1, get_height(), "dof");
-  }
+  roj_estimator_images images;
+  memset(&images, 0x0, sizeof(roj_estimator_images));
+  images.dof = output;
+  estimating(images, "dof");
 
-  print_progress(0, 0, "dof");
   return output;
 }
@@ -28,6 +28,18 @@ class roj_window_generator;
 #include "roj-stft-transform.hh"
 class roj_stft_transform;
 
+#include "roj-fft-plan.hh"
+class roj_fft_plan_cache;
+
+#include "roj-parallel.hh"
+class roj_parallel_job;
+
+#include "roj-stft-job.hh"
+class roj_stft_job;
+
+#include "roj-estim-kernel.hh"
+class roj_estimator_kernel;
+
 /* macros */
 
 #define CODE_WIN_D2 {2, 0}
@@ -37,27 +49,113 @@ class roj_stft_transform;
 #define CODE_WIN_T2 {0, 2}
 #define CODE_WIN_DT {1, 1}
 
+/* slot table size (max derivative and ramp order + 1) */
+#define ROJ_SLOT_ORDERS 3
+
+/* ************************************************************************************************************************* */
+/* structure definitions */
+
+/**
+* @type: struct
+* @brief: This structure contains statistics of the slot cache: numbers of requests served from the cache (hits), calculated slots (misses), slots dropped because of the memory budget (evictions), slots with invalidated columns calculated again (refreshes) and the number of these columns, as well as current and peak memory of resident slots (in bytes).
+*/
+struct roj_slot_stats{
+
+  unsigned long hits;
+  unsigned long misses;
+  unsigned long evictions;
+  unsigned long refreshes;
+  unsigned long refreshed_columns;
+  size_t resident_bytes;
+  size_t peak_bytes;
+};
+
+/**
+* @type: struct
+* @brief: This structure describes chirp-rate bins of a dense chirplet transform: a number of bins, chirp-rates of bins, a number of STFT columns and a bin index of each pixel (a row for each column). Each pixel is taken from the transform of its bin.
+*/
+struct roj_chirp_bins{
+
+  int count;
+  double* rates;
+  int width;
+  int** pixels;
+};
+
 /* ************************************************************************************************************************* */
 /* fft analyzer class definition */
 
 class roj_xxt_analyzer
   : public roj_analyzer{
 
+  friend class roj_stft_job;
+
 private:
 
-  /* calc stft */
-  virtual complex double ** transforming(int, int) =0;
+  /* prepare window generator for a column */
+  virtual bool update_window(int, roj_window_generator*) =0;
+
+  /* r2c transforms are allowed for real windows */
+  virtual bool check_real_windows(std::vector<std::pair<int, int> >);
+
+  /* sliding dft is allowed for fixed windows */
+  virtual bool check_fixed_windows();
+
+  /* chirp-rate bins of pixels (dense chirplet transform) */
+  virtual roj_chirp_bins* get_chirp_bins();
+
+  /* calc stft for many windows in one pass */
+  void transforming(std::vector<std::pair<int, int> >, std::vector<int> =std::vector<int>());
+  void refreshing(std::vector<std::pair<int, int> >);
 
 protected:
   
   /* window generator */
   roj_window_generator* m_window_gen;
   
-  /* STFT for various windows */
-  std::map<std::pair<int, int>, complex double **> m_fourier_spectra;
+  /* STFT for various windows (indexed by derivative and ramp order) */
+  roj_complex ** m_fourier_spectra[ROJ_SLOT_ORDERS][ROJ_SLOT_ORDERS];
+  roj_complex ** get_slot(std::pair<int, int>);
+  bool check_slot(std::pair<int, int>);
+
+  /* slot cache: references, last use and memory budget */
+  int m_slot_refs[ROJ_SLOT_ORDERS][ROJ_SLOT_ORDERS];
+  unsigned long m_slot_stamps[ROJ_SLOT_ORDERS][ROJ_SLOT_ORDERS];
+  unsigned long m_slot_clock;
+  size_t m_slot_budget;
+  roj_slot_stats m_slot_stats;
+
+  size_t get_slot_bytes();
+  void drop_slot(int, int);
+  void fit_slot_budget(int);
+
+  /* columns of resident slots which are not valid anymore */
+  std::vector<bool> m_stale_columns[ROJ_SLOT_ORDERS][ROJ_SLOT_ORDERS];
+  void invalidate_columns(std::vector<int>);
   
   /* allocate memory for stft */
-  complex double ** allocate_stft();
+  roj_complex ** allocate_stft();
+
+  /* calc missing stft slots */
+  void prepare_slots(std::vector<std::pair<int, int> >);
+
+  /* calc distributions by estimator kernel */
+  void estimating(roj_estimator_images, const char*);
+
+  /* copy analyzed band from fft output */
+  void copy_lines(roj_complex*, roj_complex*);
+  void copy_half_lines(roj_complex*, roj_complex*);
+
+  /* number of frames transformed together */
+  unsigned int m_batch_size;
+  unsigned int get_batch_size(unsigned int =1);
+
+  /* number of worker threads */
+  unsigned int m_threads;
+
+  /* stft engine */
+  int m_engine;
+  int select_engine(std::vector<std::pair<int, int> >, bool);
   
   /* width depends on signal length, then height 
      on fft length, as well as on frequency bandwidth */
@@ -74,6 +172,17 @@ public:
   ~roj_xxt_analyzer(); 
   
   void set_signal(roj_complex_signal*, int =1);
+  void clear_signal();
+  void set_batch_size(unsigned int =0);
+  void set_threads(unsigned int =1);
+  void set_engine(int =ROJ_AUTO_ENGINE);
+
+  /* slot cache management */
+  void set_slot_budget(size_t =0);
+  roj_complex ** acquire_slot(std::pair<int, int>);
+  void release_slot(std::pair<int, int>);
+  void release_slots();
+  roj_slot_stats get_slot_stats();
 
   /* methods for produce distributions */  
 
@@ -92,6 +201,8 @@ public:
   roj_real_matrix* get_chirp_rate_by_m_estimator ();
   roj_real_matrix* get_chirp_rate_by_d_estimator ();
   roj_real_matrix* get_chirp_rate_by_f_estimator ();
+
+  roj_estimator_images get_distributions (int);
 };
 
 #endif
@@ -26,6 +26,9 @@
 #include "roj-hough-transform.hh"
 #include "roj-fourier-spectr.hh"
 #include "roj-hilbert-equiv.hh"
+#include "roj-fft-plan.hh"
+#include "roj-parallel.hh"
+#include "roj-estim-kernel.hh"
 
 #include "roj-window-gener.hh"
 #include "roj-pulse-gener.hh"
@@ -34,13 +37,19 @@
 
 #include "roj-filter.hh"
 #include "roj-filter-bank.hh"
+#include "roj-filter-job.hh"
+#include "roj-filter-lanes.hh"
+#include "roj-ode-decim.hh"
 #include "roj-median-filter.hh"
  
 /* TF analyzers */
 #include "roj-analyzer.hh"
 #include "roj-xxt-analyzer.hh"
+#include "roj-stft-job.hh"
 #include "roj-fft-analyzer.hh"
 #include "roj-ode-analyzer.hh"
 #include "roj-cct-analyzer.hh"
+#include "roj-stft-stream.hh"
+#include "roj-ode-stream.hh"
 
 #endif
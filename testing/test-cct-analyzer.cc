@@ -139,6 +139,34 @@ int main(void){
   roj_real_matrix* r_energy3 = roj_time_frequency_reassign(s_delay3, i_freq3, s_energy3); 
   r_energy3->save("data-r-energy-3.txt");
 
+  /* iteration 4 *************************************************** */
+  /* dense cct with time-frequency chirp-rate */
+
+  win_gen = new roj_window_generator(rate);
+  win_gen->set_length(1600);
+  win_gen->set_type(0);
+  roj_cct_analyzer* tf_analyzer4 = new roj_cct_analyzer(arr_conf, win_gen);
+  delete win_gen;
+
+  /* chirp-rate resolution in Hz/s */
+  double resolution = 50.0;
+  tf_analyzer4->set_signal(in_signal, hop);
+  tf_analyzer4->set_chirp_rate(c_rate_med, resolution);
+
+  /* get and save spectral energy */
+  roj_real_matrix* s_energy4 = tf_analyzer4->get_spectral_energy();
+  s_energy4->save("data-s-energy-4.txt");
+
+  /* refinement: chirp-rate is replaced in the same analyzer,
+     only columns with a changed chirp-rate are calculated again */
+  roj_real_matrix* c_rate4 = tf_analyzer4->get_chirp_rate(2);
+  roj_real_matrix* c_rate4_med = median_filter->smart_filtering(c_rate4, hop_med, vop_med);
+  tf_analyzer4->set_rate_interpolation(true);
+  tf_analyzer4->set_chirp_rate(c_rate4_med, resolution);
+
+  roj_real_matrix* s_energy5 = tf_analyzer4->get_spectral_energy();
+  s_energy5->save("data-s-energy-5.txt");
+
   /* ending *************************************************** */
 
   return EXIT_SUCCESS;
@@ -0,0 +1,145 @@
+/* *************************************************** *
+ * This file is a part of ccROJ project (version 0-49) *
+ * distributed under GNU General Public License v3.0.  *
+ * Please visit the webpage: github.com/dsp-box/ccROJ  *
+ * for more information.                               *
+ *                       contact: Krzysztof Czarnecki  *
+ *                email: czarnecki.krzysiek@gmail.com  *
+ * *************************************************** */
+
+/* external headers */
+#include <stdlib.h>
+#include <stdio.h>
+
+/* internal roj headers */
+#include "../roj.hh"
+
+int main(void){
+
+  print_roj_info ();
+
+  /* signal load from a wav file */
+  char* wav_name = "mail.wav";
+  roj_complex_signal* in_signal = new roj_complex_signal(wav_name);
+  double rate = in_signal->get_config().rate;
+  
+  /* array configuration is used in Fourier analyzer */
+  roj_array_config arr_conf;
+  arr_conf.min = -in_signal->get_config().rate / 10;
+  arr_conf.max = in_signal->get_config().rate / 10;
+  arr_conf.length = 4096;
+  
+  /* finite window definition */
+  roj_window_generator* win_gen = new roj_window_generator(rate);
+  win_gen->set_length(750);
+  
+  /* create TF Fourier analyzer */
+  roj_fft_analyzer* tf_analyzer = new roj_fft_analyzer(arr_conf, win_gen);
+  tf_analyzer->set_signal(in_signal, 5);
+  delete win_gen;
+
+  /* get energy, IF, delay and chirp rate in one pass */
+  roj_estimator_images images = tf_analyzer->get_distributions(DIST_ENERGY | DIST_IFREQ_1 | DIST_DELAY | DIST_CR_F);
+
+  /* the same distribution by a separate call */
+  roj_real_matrix* c_rate = tf_analyzer->get_chirp_rate(CR_F_ESTIMATOR);
+  roj_image_config conf = c_rate->get_config();
+
+  int differences = 0;
+  for(int n=0; n<conf.x.length; n++)
+    for(int k=0; k<conf.y.length; k++)
+      if(c_rate->m_data[n][k] != images.f_rate->m_data[n][k])
+	differences++;
+  
+  if(differences>0){
+    fprintf(stderr, "fused and separate distributions differ in %d pixels\n", differences);
+    return EXIT_FAILURE;
+  }
+
+  /* fused distributions of a synthetic LFM chirp are compared with its known parameters */
+  roj_signal_config lfm_conf;
+  lfm_conf.length = 8000;
+  lfm_conf.rate = 8000.0;
+  lfm_conf.start = 0.0;
+
+  double f_start = 500.0;
+  double lfm_rate = 1200.0;
+  roj_complex_signal* lfm_signal = new roj_complex_signal(lfm_conf);
+  for(int n=0; n<lfm_conf.length; n++){
+    double time = lfm_conf.start + n / lfm_conf.rate;
+    lfm_signal->m_waveform[n] = cexp(I*TWO_PI * (f_start * time + 0.5 * lfm_rate * time * time));
+  }
+
+  roj_array_config lfm_arr_conf;
+  lfm_arr_conf.min = 0.0;
+  lfm_arr_conf.max = 2500.0;
+  lfm_arr_conf.length = 1024;
+
+  roj_window_generator* lfm_win_gen = new roj_window_generator(lfm_conf.rate);
+  lfm_win_gen->set_length(401);
+  roj_fft_analyzer* lfm_analyzer = new roj_fft_analyzer(lfm_arr_conf, lfm_win_gen);
+  lfm_analyzer->set_signal(lfm_signal, 40);
+  delete lfm_win_gen;
+  delete lfm_signal;
+
+  roj_estimator_images lfm_images = lfm_analyzer->get_distributions(DIST_ENERGY | DIST_IFREQ_1 | DIST_DELAY | DIST_CR_F);
+  roj_image_config lfm_img_conf = lfm_images.energy->get_config();
+  double t_step = (lfm_img_conf.x.max - lfm_img_conf.x.min) / (lfm_img_conf.x.length - 1);
+  double f_step = (lfm_img_conf.y.max - lfm_img_conf.y.min) / (lfm_img_conf.y.length - 1);
+
+  int errors = 0;
+  for(int n=0; n<lfm_img_conf.x.length; n++){
+
+    /* energy ridge follows the instantaneous frequency */
+    double time = lfm_img_conf.x.min + n * t_step;
+    int ridge = 0;
+    for(int k=1; k<lfm_img_conf.y.length; k++)
+      if(lfm_images.energy->m_data[n][k] > lfm_images.energy->m_data[n][ridge])
+	ridge = k;
+
+    double ifreq = f_start + lfm_rate * time;
+    if(fabs(lfm_img_conf.y.min + ridge * f_step - ifreq) > 1.5 * f_step)
+      errors++;
+
+    /* near the ridge, IF is close to the chirp and reassigned points lie on it */
+    for(int k=ridge-2; k<=ridge+2; k++){
+      double i_freq = lfm_images.ifreq_1->m_data[n][k];
+      double delay = lfm_images.delay->m_data[n][k];
+      if(fabs(i_freq - ifreq) > 2.0 * f_step)
+	errors++;
+      if(fabs(i_freq - (f_start + lfm_rate * (time + delay))) > 0.01)
+	errors++;
+      if(fabs(lfm_images.f_rate->m_data[n][k] - lfm_rate) > 0.01 * lfm_rate)
+	errors++;
+    }
+  }
+
+  if(errors>0){
+    fprintf(stderr, "fused distributions of LFM chirp are wrong in %d cases\n", errors);
+    return EXIT_FAILURE;
+  }
+
+  delete lfm_images.energy;
+  delete lfm_images.ifreq_1;
+  delete lfm_images.delay;
+  delete lfm_images.f_rate;
+  delete lfm_analyzer;
+
+  /* time frequency reassignment */
+  roj_real_matrix* r_energy = roj_time_frequency_reassign(images.delay, images.ifreq_1, images.energy); 
+  r_energy->save("data-r-energy.txt");
+  images.f_rate->save("data-c-rate.txt");
+  
+  /* cleanning */
+  delete images.energy;
+  delete images.ifreq_1;
+  delete images.delay;
+  delete images.f_rate;
+  delete r_energy;
+  delete c_rate;
+
+  delete tf_analyzer;
+  delete in_signal;
+  
+  return EXIT_SUCCESS;
+}
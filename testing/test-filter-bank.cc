@@ -0,0 +1,132 @@
+/* *************************************************** *
+ * This file is a part of ccROJ project (version 0-49) *
+ * distributed under GNU General Public License v3.0.  *
+ * Please visit the webpage: github.com/dsp-box/ccROJ  *
+ * for more information.                               *
+ *                       contact: Krzysztof Czarnecki  *
+ *                email: czarnecki.krzysiek@gmail.com  *
+ * *************************************************** */
+
+/* external headers */
+#include <stdlib.h>
+#include <stdio.h>
+
+/* internal roj headers */
+#include "../roj.hh"
+
+/* the largest difference of channels relative to the peak of reference channels */
+double compare_channels(roj_complex_signal** a_ref, roj_complex_signal** a_out, int a_count){
+
+  double peak = 0.0;
+  double error = 0.0;
+  for(int k=0; k<a_count; k++){
+    roj_signal_config conf = a_ref[k]->get_config();
+    if(a_out[k]->get_config().length != conf.length)
+      return 1.0;
+
+    for(int n=0; n<conf.length; n++){
+      peak = fmax(peak, cabs(a_ref[k]->m_waveform[n]));
+      error = fmax(error, cabs(a_out[k]->m_waveform[n] - a_ref[k]->m_waveform[n]));
+    }
+  }
+  return error / peak;
+}
+
+void delete_channels(roj_complex_signal** a_signals, int a_count){
+
+  for(int k=0; k<a_count; k++)
+    delete a_signals[k];
+  delete [] a_signals;
+}
+
+int main(void){
+
+  print_roj_info ();
+
+  /* a tone and an LFM chirp */
+  roj_signal_config sig_conf;
+  sig_conf.length = 3001;
+  sig_conf.rate = 8000.0;
+  sig_conf.start = 0.0;
+
+  roj_complex_signal* in_signal = new roj_complex_signal(sig_conf);
+  for(int n=0; n<sig_conf.length; n++){
+    double time = n / sig_conf.rate;
+    in_signal->m_waveform[n] = cexp(I*TWO_PI * 300.0 * time) + 0.5 * cexp(I*TWO_PI * (-1500.0 * time + 2000.0 * time * time));
+  }
+
+  /* channel counts which are not multiples of the lane width */
+  int counts[] = {5, 37};
+  int orders[] = {1, 3, 5, 7};
+  int hops[] = {1, 3, 8};
+
+  /* the scalar reference is a direct form, whose rounding errors grow with the order;
+     vector versions differ by contraction to FMA and the decimator sums partial fractions */
+  double lanes_tolerance[] = {1E-14, 1E-11, 1E-8, 1E-5};
+  double decim_tolerance[] = {1E-13, 1E-10, 1E-7, 1E-4};
+
+  const char* isas[] = {"generic", "avx2", "avx512"};
+  int failures = 0;
+
+  for(int i=0; i<3; i++){
+
+    if(!roj_filter_lanes :: set_isa(isas[i])){
+      printf("%s is not supported\n", isas[i]);
+      continue;
+    }
+
+    for(int c=0; c<2; c++)
+      for(int o=0; o<4; o++)
+	for(int h=0; h<3; h++){
+
+	  roj_array_config arr_conf;
+	  arr_conf.min = -2000.0;
+	  arr_conf.max = 2000.0;
+	  arr_conf.length = counts[c];
+
+	  roj_filter_generator filter_gen(sig_conf.rate);
+	  filter_gen.set_spread(0.002);
+	  filter_gen.set_order(orders[o]);
+
+	  /* scalar reference */
+	  roj_filter_bank* ref_bank = new roj_filter_bank(arr_conf, &filter_gen);
+	  roj_complex_signal** ref = new roj_complex_signal* [counts[c]];
+	  for(int k=0; k<counts[c]; k++)
+	    ref[k] = ref_bank->filter_channel(k, in_signal, hops[h]);
+	  delete ref_bank;
+
+	  /* vectorized engine */
+	  roj_filter_bank* lanes_bank = new roj_filter_bank(arr_conf, &filter_gen);
+	  roj_complex_signal** lanes = new roj_complex_signal* [counts[c]];
+	  lanes_bank->filter_lanes(0, counts[c], in_signal, lanes, hops[h]);
+	  delete lanes_bank;
+
+	  /* decimating mode */
+	  roj_filter_bank* decim_bank = new roj_filter_bank(arr_conf, &filter_gen);
+	  decim_bank->set_decimation();
+	  roj_complex_signal** decim = new roj_complex_signal* [counts[c]];
+	  decim_bank->decimate(0, counts[c], in_signal, decim, hops[h]);
+	  delete decim_bank;
+
+	  double lanes_error = compare_channels(ref, lanes, counts[c]);
+	  double decim_error = compare_channels(ref, decim, counts[c]);
+	  printf("%s: channels %d, order %d, hop %d: lanes %.1e, decimator %.1e\n", isas[i], counts[c], orders[o], hops[h], lanes_error, decim_error);
+
+	  if(lanes_error > lanes_tolerance[o] or decim_error > decim_tolerance[o])
+	    failures++;
+
+	  delete_channels(ref, counts[c]);
+	  delete_channels(lanes, counts[c]);
+	  delete_channels(decim, counts[c]);
+	}
+  }
+  roj_filter_lanes :: set_isa();
+
+  if(failures>0){
+    fprintf(stderr, "filter engines differ from the scalar path in %d cases\n", failures);
+    return EXIT_FAILURE;
+  }
+
+  delete in_signal;
+  return EXIT_SUCCESS;
+}
@@ -77,6 +77,38 @@ int main(void){
     roj_real_matrix* c_rate = tf_analyzer.get_chirp_rate_by_m_estimator();
   */
   c_rate->save("data-c-rate.txt"); 
+
+  /* the same analysis with other window families */
+  char types[] = {ROJ_HANN_WINDOW, ROJ_GAUSS_WINDOW, ROJ_KAISER_WINDOW, ROJ_DPSS_WINDOW};
+  for(int w=0; w<4; w++){
+    
+    win_gen.set_type(types[w]);
+    roj_fft_analyzer win_analyzer = roj_fft_analyzer(arr_conf, &win_gen);
+    win_analyzer.set_signal(&in_sig, 10);
+    roj_estimator_images images = win_analyzer.get_distributions(DIST_ENERGY | DIST_CR_F);
+
+    /* chirp rate at energy peaks of the rising chirp (above 100 Hz) should be equal to 1000 Hz/s */
+    roj_image_config conf = images.energy->get_config();
+    double error = 0.0;
+    for(int n=conf.x.length/4; n<3*conf.x.length/4; n++){
+      int first = (100.0 - conf.y.min) / (conf.y.max - conf.y.min) * (conf.y.length-1);
+      int peak = first;
+      for(int k=first+1; k<conf.y.length; k++)
+	if(images.energy->m_data[n][k] > images.energy->m_data[n][peak])
+	  peak = k;
+      double c = images.f_rate->m_data[n][peak];
+      error = fmax(error, fabs(c-1000));
+    }
+    
+    printf("window %d: max chirp-rate error %g Hz/s\n", (int)types[w], error);
+    delete images.energy;
+    delete images.f_rate;
+
+    if(error>50.0){
+      fprintf(stderr, "chirp-rate is not estimated with window %d\n", (int)types[w]);
+      return EXIT_FAILURE;
+    }
+  }
      
   /* cleanning */
   delete s_energy;
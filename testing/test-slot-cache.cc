@@ -0,0 +1,141 @@
+/* *************************************************** *
+ * This file is a part of ccROJ project (version 0-49) *
+ * distributed under GNU General Public License v3.0.  *
+ * Please visit the webpage: github.com/dsp-box/ccROJ  *
+ * for more information.                               *
+ *                       contact: Krzysztof Czarnecki  *
+ *                email: czarnecki.krzysiek@gmail.com  *
+ * *************************************************** */
+
+/* external headers */
+#include <stdlib.h>
+#include <stdio.h>
+
+/* internal roj headers */
+#include "../roj.hh"
+
+/* the number of failed checks of the cache state after a call */
+int check_stats(roj_xxt_analyzer* a_analyzer, roj_slot_stats* a_last, size_t a_budget, const char* a_name, bool a_evicted){
+
+  roj_slot_stats stats = a_analyzer->get_slot_stats();
+  printf("%s: resident %lu of %lu bytes, hits %lu, misses %lu, evictions %lu\n", a_name, (unsigned long)stats.resident_bytes, (unsigned long)a_budget, stats.hits, stats.misses, stats.evictions);
+
+  int failures = 0;
+  if(stats.resident_bytes > a_budget)
+    failures++;
+  if(stats.misses <= a_last->misses)
+    failures++;
+  if(a_evicted and stats.evictions <= a_last->evictions)
+    failures++;
+
+  *a_last = stats;
+  return failures;
+}
+
+/* the number of pixels which differ */
+int compare_images(roj_real_matrix* a_first, roj_real_matrix* a_second){
+
+  roj_image_config conf = a_first->get_config();
+  int differences = 0;
+  for(int n=0; n<conf.x.length; n++)
+    for(int k=0; k<conf.y.length; k++)
+      if(a_first->m_data[n][k] != a_second->m_data[n][k])
+	differences++;
+  return differences;
+}
+
+int main(void){
+
+  print_roj_info ();
+
+  /* an LFM chirp */
+  roj_signal_config sig_conf;
+  sig_conf.length = 4000;
+  sig_conf.rate = 8000.0;
+  sig_conf.start = 0.0;
+
+  roj_complex_signal* in_signal = new roj_complex_signal(sig_conf);
+  for(int n=0; n<sig_conf.length; n++){
+    double time = n / sig_conf.rate;
+    in_signal->m_waveform[n] = cexp(I*TWO_PI * (-1000.0 * time + 2000.0 * time * time));
+  }
+
+  roj_array_config arr_conf;
+  arr_conf.min = -2000.0;
+  arr_conf.max = 2000.0;
+  arr_conf.length = 512;
+
+  roj_window_generator* win_gen = new roj_window_generator(sig_conf.rate);
+  win_gen->set_length(201);
+
+  roj_fft_analyzer* tf_analyzer = new roj_fft_analyzer(arr_conf, win_gen);
+  tf_analyzer->set_signal(in_signal, 4);
+  delete win_gen;
+
+  /* slot codes: window derivative order and time-ramp order */
+  std::pair<int, int> code_zero(0, 0);
+  std::pair<int, int> code_d(1, 0);
+  std::pair<int, int> code_t(0, 1);
+
+  /* memory of one slot */
+  tf_analyzer->acquire_slot(code_zero);
+  size_t slot_bytes = tf_analyzer->get_slot_stats().resident_bytes;
+  tf_analyzer->release_slot(code_zero);
+
+  /* each estimator below needs two slots, together they need three */
+  size_t budget = 2 * slot_bytes + slot_bytes / 2;
+  tf_analyzer->set_slot_budget(budget);
+  roj_slot_stats last = tf_analyzer->get_slot_stats();
+  int failures = 0;
+
+  roj_real_matrix* first_freq = tf_analyzer->get_instantaneous_frequency_by_1_estimator();
+  failures += check_stats(tf_analyzer, &last, budget, "frequency", false);
+
+  roj_real_matrix* delay = tf_analyzer->get_spectral_delay();
+  failures += check_stats(tf_analyzer, &last, budget, "delay", true);
+
+  /* evicted slots are calculated again with the same result */
+  roj_real_matrix* second_freq = tf_analyzer->get_instantaneous_frequency_by_1_estimator();
+  failures += check_stats(tf_analyzer, &last, budget, "frequency", true);
+  failures += compare_images(first_freq, second_freq);
+
+  /* an acquired slot is not evicted, the other least recently used slot is dropped */
+  delete tf_analyzer->get_spectral_energy();
+  roj_complex** slot_t = tf_analyzer->acquire_slot(code_t);
+  failures += check_stats(tf_analyzer, &last, budget, "acquire", true);
+
+  int height = arr_conf.length;
+  roj_complex* saved = new roj_complex[height];
+  for(int k=0; k<height; k++)
+    saved[k] = slot_t[0][k];
+
+  tf_analyzer->acquire_slot(code_d);
+  failures += check_stats(tf_analyzer, &last, budget, "acquire", true);
+
+  /* the acquired slot is still resident (a hit) and unchanged */
+  if(tf_analyzer->acquire_slot(code_t) != slot_t or tf_analyzer->get_slot_stats().misses != last.misses)
+    failures++;
+  for(int k=0; k<height; k++)
+    if(slot_t[0][k] != saved[k])
+      failures++;
+
+  /* released slots are dropped */
+  tf_analyzer->release_slot(code_t);
+  tf_analyzer->release_slot(code_t);
+  tf_analyzer->release_slot(code_d);
+  if(tf_analyzer->get_slot_stats().resident_bytes != 0)
+    failures++;
+
+  if(failures>0){
+    fprintf(stderr, "slot cache failed in %d checks\n", failures);
+    return EXIT_FAILURE;
+  }
+
+  delete [] saved;
+  delete first_freq;
+  delete second_freq;
+  delete delay;
+  delete tf_analyzer;
+  delete in_signal;
+  return EXIT_SUCCESS;
+}
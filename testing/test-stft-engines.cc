@@ -0,0 +1,149 @@
+/* *************************************************** *
+ * This file is a part of ccROJ project (version 0-49) *
+ * distributed under GNU General Public License v3.0.  *
+ * Please visit the webpage: github.com/dsp-box/ccROJ  *
+ * for more information.                               *
+ *                       contact: Krzysztof Czarnecki  *
+ *                email: czarnecki.krzysiek@gmail.com  *
+ * *************************************************** */
+
+/* external headers */
+#include <stdlib.h>
+#include <stdio.h>
+
+/* internal roj headers */
+#include "../roj.hh"
+
+/* distributions of an analyzer with a given engine and number of threads */
+roj_estimator_images analyze(roj_complex_signal* a_signal, roj_array_config a_arr_conf, int a_hop, int a_engine, int a_threads, int a_batch_size, int a_mask){
+
+  roj_window_generator* win_gen = new roj_window_generator(a_signal->get_config().rate);
+  win_gen->set_length(401);
+
+  roj_fft_analyzer* tf_analyzer = new roj_fft_analyzer(a_arr_conf, win_gen);
+  tf_analyzer->set_engine(a_engine);
+  tf_analyzer->set_threads(a_threads);
+  tf_analyzer->set_batch_size(a_batch_size);
+  tf_analyzer->set_signal(a_signal, a_hop);
+  delete win_gen;
+
+  roj_estimator_images images = tf_analyzer->get_distributions(a_mask);
+  delete tf_analyzer;
+  return images;
+}
+
+/* the number of significant pixels which differ from the reference (chirp-rate is compared if it is calculated) */
+int compare(roj_estimator_images a_ref, roj_estimator_images a_images, double a_freq_scale, double a_rate_scale){
+
+  roj_image_config conf = a_ref.energy->get_config();
+  if(a_images.energy->get_config().x.length != conf.x.length or a_images.energy->get_config().y.length != conf.y.length)
+    return conf.x.length * conf.y.length;
+
+  double peak = 0.0;
+  for(int n=0; n<conf.x.length; n++)
+    for(int k=0; k<conf.y.length; k++)
+      peak = fmax(peak, a_ref.energy->m_data[n][k]);
+
+  int differences = 0;
+  double energy_error = 0.0;
+  double freq_error = 0.0;
+  double rate_error = 0.0;
+  for(int n=0; n<conf.x.length; n++)
+    for(int k=0; k<conf.y.length; k++){
+
+      /* pixels with small energy have ill-conditioned estimates */
+      double ref = a_ref.energy->m_data[n][k];
+      if(ref < 1E-3 * peak)
+	continue;
+
+      double error = fabs(a_images.energy->m_data[n][k] - ref) / ref;
+      energy_error = fmax(energy_error, error);
+      if(error > 1E-9)
+	differences++;
+
+      error = fabs(a_images.ifreq_1->m_data[n][k] - a_ref.ifreq_1->m_data[n][k]) / a_freq_scale;
+      freq_error = fmax(freq_error, error);
+      if(error > 1E-9)
+	differences++;
+
+      if(a_images.f_rate == NULL)
+	continue;
+      
+      error = fabs(a_images.f_rate->m_data[n][k] - a_ref.f_rate->m_data[n][k]) / a_rate_scale;
+      rate_error = fmax(rate_error, error);
+      if(error > 1E-9)
+	differences++;
+    }
+
+  printf("energy %.1e, frequency %.1e, chirp-rate %.1e\n", energy_error, freq_error, rate_error);
+  return differences;
+}
+
+void delete_images(roj_estimator_images a_images){
+
+  delete a_images.energy;
+  delete a_images.ifreq_1;
+  if(a_images.f_rate != NULL)
+    delete a_images.f_rate;
+}
+
+int main(void){
+
+  print_roj_info ();
+
+  /* a tone and an LFM chirp */
+  roj_signal_config sig_conf;
+  sig_conf.length = 6000;
+  sig_conf.rate = 8000.0;
+  sig_conf.start = 0.0;
+
+  double c_rate = 2000.0;
+  roj_complex_signal* in_signal = new roj_complex_signal(sig_conf);
+  for(int n=0; n<sig_conf.length; n++){
+    double time = n / sig_conf.rate;
+    in_signal->m_waveform[n] = cexp(I*TWO_PI * 450.0 * time) + 0.5 * cexp(I*TWO_PI * (-1500.0 * time + 0.5 * c_rate * time * time));
+  }
+
+  /* a wide band with hop 1 and a narrow band with hop 5 */
+  roj_array_config arr_confs[2];
+  arr_confs[0].min = -3000.0;
+  arr_confs[0].max = 3000.0;
+  arr_confs[0].length = 1024;
+  arr_confs[1].min = 200.0;
+  arr_confs[1].max = 700.0;
+  arr_confs[1].length = 2048;
+  int hops[] = {1, 5};
+
+  int engines[] = {ROJ_FFT_ENGINE, ROJ_PRUNED_ENGINE, ROJ_SLIDING_ENGINE};
+  const char* names[] = {"fft", "pruned", "sliding"};
+  int threads[] = {1, 4};
+
+  /* chirp-rate needs time-ramped windows, which are not cosine sums, so the sliding engine is checked without it */
+  int full_mask = DIST_ENERGY | DIST_IFREQ_1 | DIST_CR_F;
+  int masks[] = {full_mask, full_mask, DIST_ENERGY | DIST_IFREQ_1};
+  int differences = 0;
+
+  for(int b=0; b<2; b++){
+
+    /* frames transformed one by one */
+    roj_estimator_images ref = analyze(in_signal, arr_confs[b], hops[b], ROJ_FFT_ENGINE, 1, 1, full_mask);
+
+    for(int e=0; e<3; e++)
+      for(int t=0; t<2; t++){
+	printf("band %d, %s engine, %d threads: ", b, names[e], threads[t]);
+	roj_estimator_images images = analyze(in_signal, arr_confs[b], hops[b], engines[e], threads[t], 0, masks[e]);
+	differences += compare(ref, images, sig_conf.rate, c_rate);
+	delete_images(images);
+      }
+
+    delete_images(ref);
+  }
+
+  if(differences>0){
+    fprintf(stderr, "engines differ in %d pixels\n", differences);
+    return EXIT_FAILURE;
+  }
+
+  delete in_signal;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,100 @@
+/* *************************************************** *
+ * This file is a part of ccROJ project (version 0-49) *
+ * distributed under GNU General Public License v3.0.  *
+ * Please visit the webpage: github.com/dsp-box/ccROJ  *
+ * for more information.                               *
+ *                       contact: Krzysztof Czarnecki  *
+ *                email: czarnecki.krzysiek@gmail.com  *
+ * *************************************************** */
+
+/* external headers */
+#include <stdlib.h>
+#include <stdio.h>
+
+/* internal roj headers */
+#include "../roj.hh"
+
+/* a sink which compares stream columns with a whole image */
+class compare_sink : public roj_column_sink{
+public:
+
+  roj_real_matrix* m_image;
+  int m_column;
+  int m_differences;
+
+  compare_sink(roj_real_matrix* a_image){
+    m_image = a_image;
+    m_column = 0;
+    m_differences = 0;
+  }
+  
+  void write_column(double a_time, roj_array_config a_freq, roj_estimator_maps a_maps){
+
+    /* time of the column in the whole image */
+    roj_image_config conf = m_image->get_config();
+    double time = conf.x.min + m_column * (conf.x.max - conf.x.min) / (conf.x.length - 1);
+    if(fabs(a_time - time) > 1E-9 * (fabs(time) + 1.0))
+      m_differences++;
+    
+    for(int k=0; k<a_freq.length; k++){
+      double ref = m_image->m_data[m_column][k];
+      if(fabs(a_maps.energy[k] - ref) > 1E-9 * (fabs(ref) + 1E-9))
+	m_differences++;
+    }
+    m_column++;
+  }
+};
+
+int main(void){
+
+  print_roj_info ();
+
+  /* signal load from a wav file */
+  char* wav_name = "mail.wav";
+  roj_complex_signal* in_signal = new roj_complex_signal(wav_name);
+  roj_signal_config sig_conf = in_signal->get_config();
+  
+  /* array configuration is used in Fourier analyzer */
+  roj_array_config arr_conf;
+  arr_conf.min = -sig_conf.rate / 10;
+  arr_conf.max = sig_conf.rate / 10;
+  arr_conf.length = 4096;
+  
+  /* finite window definition */
+  roj_window_generator* win_gen = new roj_window_generator(sig_conf.rate);
+  win_gen->set_length(750);
+  
+  /* energy of the whole signal */
+  roj_fft_analyzer* tf_analyzer = new roj_fft_analyzer(arr_conf, win_gen);
+  tf_analyzer->set_signal(in_signal, 5);
+  roj_real_matrix* s_energy = tf_analyzer->get_spectral_energy();
+  int width = s_energy->get_config().x.length;
+  delete tf_analyzer;
+  
+  /* the same energy calculated by a stream of short chunks */
+  compare_sink* sink = new compare_sink(s_energy);
+  roj_stft_stream* stream = new roj_stft_stream(arr_conf, win_gen, 5, sig_conf.start);
+  stream->set_sink(sink);
+  stream->set_block_size(64);
+  delete win_gen;
+
+  int chunk = 1000;
+  for(int n=0; n<sig_conf.length; n+=chunk){
+    int count = sig_conf.length - n < chunk ? sig_conf.length - n : chunk;
+    stream->write(&in_signal->m_waveform[n], count);
+  }
+  stream->flush();
+
+  if(sink->m_column != width or sink->m_differences > 0){
+    fprintf(stderr, "stream gives %d columns (expected %d) with %d different pixels\n", sink->m_column, width, sink->m_differences);
+    return EXIT_FAILURE;
+  }
+  
+  /* cleanning */
+  delete stream;
+  delete sink;
+  delete s_energy;
+  delete in_signal;
+  
+  return EXIT_SUCCESS;
+}